@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace OIF
+{
+	// Limit counter as written to the co-save, keyed by the rule's stable ID instead of its index
+	struct SavedCount {
+		std::uint32_t ruleID;
+		std::uint32_t sourceID;
+		std::uint32_t targetID;
+		std::uint32_t value;
+	};
+
+	// Bulk layout of the LCNT co-save record, kept free of CommonLib so tools/ can build it on its own
+	namespace CounterCodec
+	{
+		// Sorts counts by (rule, source, target) and writes them as delta-encoded varints
+		std::vector<std::uint8_t> Encode(std::vector<SavedCount>& counts);
+
+		// False if the data is truncated, malformed or has trailing bytes
+		bool Decode(std::span<const std::uint8_t> data, std::vector<SavedCount>& out);
+	}
+}
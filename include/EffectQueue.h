@@ -0,0 +1,112 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include "FrameDriver.h"
+
+namespace OIF
+{
+	enum class EffectPriority : std::uint8_t {
+		kImmediate,																			// notifications, sounds, toggles - cheap and noticeable when late
+		kNormal,
+		kHeavy,																				// actor spawns, swaps, console commands
+		kTotal
+	};
+
+	// Identifies effects that may be merged while both are still queued
+	struct CoalesceKey {
+		std::uint64_t forms{ 0 };															// hash of every item field that changes the outcome
+		RE::RefHandle source{ 0 };															// only set for effects that act on the source
+		RE::RefHandle target{ 0 };
+		std::uint8_t type{ 0 };																// EffectType
+
+		bool operator==(const CoalesceKey&) const = default;
+	};
+
+	struct CoalesceKeyHash {
+		std::size_t operator()(const CoalesceKey& key) const {
+			return static_cast<std::size_t>(key.forms ^ (static_cast<std::uint64_t>(key.target) << 8) ^ (static_cast<std::uint64_t>(key.source) << 36) ^ key.type);
+		}
+	};
+
+	// Effects wait here instead of the SKSE task queue and run from the player update under a per-frame time budget.
+	// While the player update is paused (menus) a task drains the queue instead, so effects are not held back
+	class EffectQueue {
+
+	private:
+		EffectQueue(const EffectQueue&) = delete;
+		EffectQueue& operator=(const EffectQueue&) = delete;
+
+		EffectQueue() : _frameDriver([this]() { return DrainWhilePaused(); }) {}
+
+	public:
+		// repeats - number of merged duplicates, 1 if none; counts - per item counts summed over the merged duplicates, empty if not tracked
+		using Job = std::function<void(std::uint32_t repeats, std::span<const std::uint32_t> counts)>;
+
+		struct FrameStats {
+			std::size_t executed{ 0 };														// jobs run in the frame
+			std::size_t remaining{ 0 };														// jobs carried over to the next frame
+			std::size_t merged{ 0 };														// duplicates folded into queued jobs since the previous drain
+			float drainMs{ 0.0f };															// time spent running jobs
+		};
+
+		static EffectQueue* GetSingleton();
+
+		void Push(EffectPriority priority, Job job);
+
+		// A job with the same key that is still queued absorbs this one and runs once with a higher repeat count,
+		// counts of the absorbed job are added to the queued job's counts item by item
+		void Push(EffectPriority priority, Job job, const CoalesceKey& key, std::vector<std::uint32_t> counts = {});
+
+		// Adds from to into item by item, false if the two do not describe the same items
+		static bool MergeCounts(std::vector<std::uint32_t>& into, std::span<const std::uint32_t> from);
+
+		// Called once per frame from the player update
+		void RunFrame(float budgetMs);
+		void Clear();
+
+		std::size_t GetDepth() const;
+		FrameStats GetLastFrameStats() const;
+
+		// Logs the peaks since the previous report and resets them
+		void ReportMetrics();
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr std::size_t kPriorityCount = static_cast<std::size_t>(EffectPriority::kTotal);
+
+		struct Entry {
+			Job job;
+			std::uint32_t repeats{ 1 };
+			bool coalescable{ false };
+			CoalesceKey key;
+			std::vector<std::uint32_t> counts;
+		};
+
+		void Enqueue(EffectPriority priority, Entry entry);
+
+		// Runs jobs in priority order until budgetMs is spent; at least one job runs so the queue always makes progress
+		void Drain(float budgetMs);
+		bool DrainWhilePaused();
+
+		mutable std::mutex _mutex;
+		std::array<std::deque<Entry>, kPriorityCount> _jobs;
+		std::unordered_map<CoalesceKey, Entry*, CoalesceKeyHash> _queuedByKey;				// deque growth at the back keeps these pointers valid
+		std::size_t _depth{ 0 };
+		FrameDriver _frameDriver;
+
+		FrameStats _lastStats;																// guarded by _mutex
+		std::size_t _peakDepth{ 0 };
+		float _peakDrainMs{ 0.0f };
+		std::uint32_t _carriedFrames{ 0 };													// frames that ended with jobs left over
+		std::size_t _mergedSinceDrain{ 0 };
+		std::size_t _mergedSinceReport{ 0 };
+	};
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <span>
+#include <unordered_set>
+#include <vector>
+#include "FrameDriver.h"
+#include "MPSCQueue.h"
+#include "RuleManager.h"
+
+namespace OIF
+{
+	// Producer of a queued event, tells the consumer how to turn the record into rule contexts
+	enum class EventOrigin : std::uint8_t {
+		kActivate,
+		kHit,
+		kMagicEffectApply,
+		kGrab,
+		kRelease,
+		kLanding,
+		kCellAttach,
+		kCellDetach,
+		kDestructionStage,
+		kExplosion,
+		kWeatherChange,
+		kProjectileImpact
+	};
+
+	// Compact copy of an engine event, only IDs and plain values so it stays valid on any thread
+	struct EventRecord {
+		EventOrigin origin{ EventOrigin::kActivate };
+		EventType event{ EventType::kNone };											// landing only, which of throw/telekinesis/drop
+		std::int32_t stage{ -1 };														// destruction stage
+		RE::FormID source{ 0 };
+		RE::FormID target{ 0 };															// target reference, projectile base for impacts
+		RE::FormID form{ 0 };															// hit source, magic effect, explosion or weather
+		RE::FormID extra{ 0 };															// projectile or cell
+		std::array<float, 3> position{};												// explosion centre or impact point
+		float radius{ 0.0f };															// explosion or impact search radius
+
+		bool operator==(const EventRecord&) const = default;
+	};
+
+	struct EventRecordHash {
+		std::size_t operator()(const EventRecord& record) const;
+	};
+
+	// Sinks and hooks push records from any thread (script events, Havok, the main thread) without locking.
+	// The player update drains the queue once per frame, drops duplicates and hands the rest to one consumer call,
+	// while the player update is paused a single task drains it instead
+	class EventQueue {
+
+	private:
+		EventQueue(const EventQueue&) = delete;
+		EventQueue& operator=(const EventQueue&) = delete;
+
+		EventQueue() : _frameDriver([this]() { return DrainWhilePaused(); }) {}
+
+	public:
+		using Consumer = void (*)(std::span<const EventRecord> records);
+
+		static EventQueue* GetSingleton();
+
+		// Consumer runs on the main thread with the deduplicated records of one drain
+		void SetConsumer(Consumer consumer) { _consumer.store(consumer, std::memory_order_release); }
+
+		void Push(const EventRecord& record);
+
+		// Called once per frame from the player update
+		void RunFrame();
+		void Clear();
+
+		// Logs the counters since the previous report and resets them
+		void ReportMetrics();
+
+	private:
+		static constexpr std::size_t kCapacity = 4096;
+
+		// Moves every queued record into _drained, duplicates of one drain are kept once
+		std::size_t Collect();
+		std::size_t Drain();
+		bool DrainWhilePaused();
+
+		MPSCQueue<EventRecord, kCapacity> _ring;											// consumed on the main thread only
+
+		// Records that found the ring full, rare enough for a lock
+		std::mutex _overflowMutex;
+		std::vector<EventRecord> _overflow;
+		std::atomic<bool> _hasOverflow{ false };
+
+		std::atomic<Consumer> _consumer{ nullptr };
+		FrameDriver _frameDriver;
+
+		// Consumer side, main thread only
+		std::vector<EventRecord> _drained;
+		std::unordered_set<EventRecord, EventRecordHash> _seen;
+		std::size_t _receivedSinceReport{ 0 };
+		std::size_t _duplicatesSinceReport{ 0 };
+		std::size_t _peakDrain{ 0 };
+		std::atomic<std::size_t> _overflowSinceReport{ 0 };
+	};
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "RuleManager.h"
+#include "EventQueue.h"
 #include "RE/T/TESDestructionStageChangedEvent.h"
 
 namespace OIF
@@ -154,9 +155,25 @@ namespace OIF
 
         void ContactPointCallback(const RE::hkpContactPointEvent& evn) override;
 
+        // Called once per frame on the main thread, detaches the landed bodies in one go and queues their events
+        void ProcessLandings();
+
     private:
-        std::unordered_set<std::uint32_t> processedObjects;
-        std::vector<RE::hkpRigidBody*> bodiesToCleanup;
+        struct PendingLanding {
+            RE::FormID objectID{ 0 };
+            std::uint32_t slot{ 0 };                                                        // index claimed in landedObjects
+            EventType event{ EventType::kNone };
+        };
+
+        static constexpr std::size_t kLandedCapacity = 1024;                                // power of two
+        static constexpr std::size_t kLandedProbe = 16;                                     // slots searched per object
+        static constexpr std::uint32_t kNoSlot = ~0u;
+
+        // Marks the object as landed from the physics thread, kNoSlot if it already is or no slot is free nearby
+        std::uint32_t TryClaim(RE::FormID objectID);
+
+        std::array<std::atomic<RE::FormID>, kLandedCapacity> landedObjects{};               // objects with an unprocessed landing, 0 - free slot
+        MPSCQueue<PendingLanding, 256> pendingLandings;                                     // filled by the physics thread, drained by ProcessLandings
         static constexpr std::uint32_t HK_PROPERTY_TELEKINESIS{ 314159 };
         static constexpr std::uint32_t HK_PROPERTY_GRABTHROWNOBJECT{ 628318 };
 		static constexpr std::uint32_t HK_PROPERTY_DROPPEDOBJECT{ 271828 };
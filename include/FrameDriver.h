@@ -0,0 +1,40 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+namespace OIF
+{
+	// Work normally drained from the player update. While the player update is paused (menus, loading screens)
+	// one SKSE task drains it instead, and keeps re-posting itself for as long as work remains
+	class FrameDriver {
+
+	private:
+		FrameDriver(const FrameDriver&) = delete;
+		FrameDriver& operator=(const FrameDriver&) = delete;
+
+	public:
+		using Drain = std::function<bool()>;												// runs one drain on the main thread, true while work remains
+
+		explicit FrameDriver(Drain drain) : _drain(std::move(drain)) {}
+
+		// Called once per frame from the player update, before any queue drains
+		static void MarkFrame() { _lastFrame.store(Clock::now(), std::memory_order_relaxed); }
+		static bool IsPaused() { return Clock::now() - _lastFrame.load(std::memory_order_relaxed) > kPausedAfter; }
+
+		// Any thread, after queueing work; posts a single drain task if the player update is paused
+		void Request();
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr auto kPausedAfter = std::chrono::milliseconds(100);					// no player update for this long counts as paused
+
+		void DrainWhilePaused();
+
+		static inline std::atomic<Clock::time_point> _lastFrame{};
+
+		Drain _drain;
+		std::atomic<bool> _posted{ false };													// a DrainWhilePaused task is in the SKSE queue
+	};
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace OIF
+{
+	// Fixed-capacity lock-free ring (Vyukov bounded queue) for many producers and one consumer.
+	// Producers never block or allocate, TryPush fails once the consumer falls a full ring behind
+	template <class T, std::size_t Capacity>
+	class MPSCQueue {
+		static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	public:
+		MPSCQueue() {
+			for (std::size_t i = 0; i < Capacity; ++i) {
+				_cells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		MPSCQueue(const MPSCQueue&) = delete;
+		MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+		// Any thread
+		bool TryPush(const T& value) {
+			std::size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+			while (true) {
+				auto& cell = _cells[pos & kMask];
+				const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+				const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+				if (diff == 0) {
+					// The cell is free for this position, claim it
+					if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+						cell.value = value;
+						cell.sequence.store(pos + 1, std::memory_order_release);
+						return true;
+					}
+				} else if (diff < 0) {
+					return false;															// the consumer has not freed this cell yet
+				} else {
+					pos = _enqueuePos.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		// Consumer thread only
+		bool TryPop(T& value) {
+			auto& cell = _cells[_dequeuePos & kMask];
+			if (cell.sequence.load(std::memory_order_acquire) != _dequeuePos + 1) return false;	// empty, or the producer is still writing
+
+			value = cell.value;
+			cell.sequence.store(_dequeuePos + Capacity, std::memory_order_release);
+			++_dequeuePos;
+			return true;
+		}
+
+	private:
+		static constexpr std::size_t kMask = Capacity - 1;
+
+		struct Cell {
+			std::atomic<std::size_t> sequence;
+			T value{};
+		};
+
+		std::array<Cell, Capacity> _cells;
+		alignas(64) std::atomic<std::size_t> _enqueuePos{ 0 };
+		alignas(64) std::size_t _dequeuePos{ 0 };
+	};
+}
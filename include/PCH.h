@@ -18,6 +18,7 @@
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
 
+#include "Settings.h"
 #include "RuleManager.h"
 #include "EventSinks.h"
 
@@ -110,16 +111,21 @@ static void OnMessage(SKSE::MessagingInterface::Message* a_msg)
 {
     switch (a_msg->type) {
     case SKSE::MessagingInterface::kDataLoaded:
-        SKSE::log::info("kDataLoaded – registering event sinks, installing hooks, and loading rules");
+        SKSE::log::info("kDataLoaded – loading rules, registering event sinks, and installing hooks");
+		Settings::GetSingleton()->Load();
+		RuleManager::GetSingleton()->LoadRules();
+		// Only the sources the loaded rules listen to are attached
 		RegisterSinks();
 		InstallHooks();
-		RuleManager::GetSingleton()->LoadRules();
         break;
 
     case SKSE::MessagingInterface::kPostLoadGame:
     case SKSE::MessagingInterface::kNewGame:
         SKSE::log::info("Game loaded – re‑loading rules");
+        Settings::GetSingleton()->Load();
         RuleManager::GetSingleton()->LoadRules();
+        RegisterSinks();
+        InstallHooks();
         break;
     }
 }
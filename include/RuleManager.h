@@ -1,6 +1,15 @@
 #pragma once
-#include <shared_mutex>
+#include <memory>
+#include <mutex>
 #include <future>
+#include <atomic>
+#include <array>
+#include <span>
+#include <shared_mutex>
+#include <deque>
+#include "Scheduler.h"
+#include "EffectQueue.h"
+#include "CounterCodec.h"
 
 namespace OIF
 {
@@ -12,7 +21,7 @@ namespace OIF
 //███████╗██║░╚███║╚██████╔╝██║░╚═╝░██║██████╔╝
 //╚══════╝╚═╝░░╚══╝░╚═════╝░╚═╝░░░░░╚═╝╚═════╝░
 
-	enum class EventType
+	enum class EventType : std::uint8_t
 	{ 
 		kNone,			// placeholder for no event (unavailable for users)
 		kActivate, 
@@ -26,7 +35,89 @@ namespace OIF
 		kWeatherChange,
 		kOnUpdate,
 		kDestructionStageChange,
-		kDrop
+		kDrop,
+		kTotal			// number of event types (unavailable for users)
+	};
+
+	inline constexpr std::size_t kEventTypeCount = static_cast<std::size_t>(EventType::kTotal);
+
+	static_assert(kEventTypeCount <= 32, "Event types must fit the 32-bit listener mask");
+
+	// Bit of an event type in the listener mask
+	inline constexpr std::uint32_t EventBit(EventType event) { return 1u << static_cast<std::uint32_t>(event); }
+
+	enum class WeaponType : std::uint8_t
+	{
+		HandToHand,
+		OneHandSword,
+		Dagger,
+		OneHandAxe,
+		OneHandMace,
+		TwoHandSword,
+		TwoHandAxe,
+		Ranged,
+		Staff,
+		Spell,
+		Scroll,
+		Shout,
+		Ability,
+		LesserPower,
+		Power,
+		Explosion,
+		Total,
+		Other
+	};
+
+	enum class AttackType : std::uint8_t
+	{
+		Regular,
+		Power,
+		Bash,
+		Charge,
+		Rotating,
+		Continuous,
+		Constant,
+		FireAndForget,
+		IgnoreWeapon,
+		OverrideData
+	};
+
+	enum class DeliveryType : std::uint8_t
+	{
+		Self,
+		Aimed,
+		TargetActor,
+		TargetLocation,
+		Touch,
+		Total,
+		None
+	};
+
+	// Bit of a hit category inside a filter mask
+	template <class E>
+	constexpr std::uint32_t HitMask(E a_value) { return 1u << static_cast<std::uint32_t>(a_value); }
+
+	enum class CompareOp : std::uint8_t
+	{
+		kNone,			// unparsed operator, never matches
+		kGreaterEqual,	// ">="
+		kLessEqual,		// "<="
+		kGreater,		// ">"
+		kLess,			// "<"
+		kEqual,			// "="
+		kNotEqual		// "!="
+	};
+
+	enum class TimeField : std::uint8_t
+	{
+		kNone,			// unknown field, never matches
+		kHour,
+		kMinute,
+		kDay,
+		kMonth,
+		kYear,
+		kDayOfWeek,
+		kGameTime
 	};
 
 	enum class EffectType { 
@@ -61,16 +152,17 @@ namespace OIF
 	struct FormListEntry {
 		std::uint32_t formID{ 0 };											// id of the form of the formlist
 		int index{ -1 };													// -1 -use the entire list
+		RE::BGSListForm* list{ nullptr };									// resolved after data load, null if the formlist is missing
 	};
 
 	struct LevelCondition {
-		std::string operator_type; 											// ">=", "=", "<", ">", "<=", "!="
+		CompareOp operator_type{ CompareOp::kNone }; 						// ">=", "=", "<", ">", "<=", "!="
 		int value{ 0 };
 	};
 
 	struct ActorValueCondition {
-		std::string actorValue; 											// "Health", "Magicka", "Stamina", etc.
-		std::string operator_type; 											// ">=", "=", "<", ">", "<=", "!="
+		RE::ActorValue actorValue{ RE::ActorValue::kNone }; 				// "Health", "Magicka", "Stamina", etc.
+		CompareOp operator_type{ CompareOp::kNone }; 						// ">=", "=", "<", ">", "<=", "!="
 		float value{ 0.0f };
 	};
 
@@ -79,7 +171,6 @@ namespace OIF
 		std::uint32_t min{ 1 };
 		std::uint32_t max{ 1 };
 		bool useRandom = false;
-		mutable bool hasRolled = false;
 	};
 
 	struct LimitCondition {
@@ -87,7 +178,6 @@ namespace OIF
 		std::uint32_t min{ 0 };
 		std::uint32_t max{ 0 };
 		bool useRandom = false;
-		mutable bool hasRolled = false;
 	};
 
 	struct ChanceCondition {
@@ -134,11 +224,12 @@ namespace OIF
 	struct TimerEntry {
 		TimerCondition time;												// time in seconds
 		std::uint32_t matchFilterRecheck{ 0 }; 								// 0 - no re-check, 1 - re-check after timer expires
+		TimerClock clock{ TimerClock::kRealTime };							// "real" - wall clock, "game" - paused with the game
 	};
 
 	struct TimeCondition {
-		std::string field;													// "hour", "minute", "day", "month", "year", "dayofweek"
-		std::string operator_type;											// ">=", "=", "<", ">", "<=", "!="
+		TimeField field{ TimeField::kNone };								// "hour", "minute", "day", "month", "year", "dayofweek"
+		CompareOp operator_type{ CompareOp::kNone };						// ">=", "=", "<", ">", "<=", "!="
 		float value{ 0.0f };
 	};
 
@@ -163,8 +254,8 @@ namespace OIF
 		std::uint32_t isStacked{ 2 };										// 0 - not in stack, 1 - in stack, 2 - all/undefined
 		
 		// New hit-specific filters
-		std::unordered_set<std::string> weaponsTypes;          	 			// weapon type categories
-		std::unordered_set<std::string> weaponsTypesNot;      				// weapon type categories to avoid
+		std::uint32_t weaponsTypes{ 0 };          	 						// weapon type categories, HitMask(WeaponType) bits
+		std::uint32_t weaponsTypesNot{ 0 };      							// weapon type categories to avoid
 		std::set<RE::BGSKeyword*> weaponsKeywords;	   						// specific weapons or spells keywords
 		std::set<RE::BGSKeyword*> weaponsKeywordsNot;						// specific weapons or spells keywords to avoid
 		std::set<RE::TESForm*> weapons;       	 							// specific weapons or spells
@@ -172,10 +263,10 @@ namespace OIF
 		std::uint32_t allowProjectiles{ 1 }; 								// 0 - no projectiles, 1 - allow projectiles
 		std::set<RE::TESForm*> projectiles;  	  							// specific projectiles
 		std::set<RE::TESForm*> projectilesNot; 								// specific projectiles to avoid
-		std::unordered_set<std::string> attackTypes;           				// attack types
-		std::unordered_set<std::string> attackTypesNot;       				// attack types to avoid
-		std::unordered_set<std::string> deliveryTypes;           			// delivery types
-		std::unordered_set<std::string> deliveryTypesNot;       			// delivery types to avoid
+		std::uint32_t attackTypes{ 0 };           							// attack types, HitMask(AttackType) bits
+		std::uint32_t attackTypesNot{ 0 };       							// attack types to avoid
+		std::uint32_t deliveryTypes{ 0 };           						// delivery types, HitMask(DeliveryType) bits
+		std::uint32_t deliveryTypesNot{ 0 };       							// delivery types to avoid
 
 		// Location and weather filters
 		std::unordered_set<RE::FormID> locations; 							// location IDs
@@ -201,6 +292,12 @@ namespace OIF
 		std::unordered_set<RE::FormID> spellsNot; 							// does not have any of these spells
 		std::unordered_set<RE::FormID> hasItem; 							// has any of these items
 		std::unordered_set<RE::FormID> hasItemNot; 							// does not have any of these items
+		std::vector<RE::BGSPerk*> perkForms;								// resolved perks, filled after data load
+		std::vector<RE::BGSPerk*> perkFormsNot;								// resolved perks to avoid
+		std::vector<RE::SpellItem*> spellForms;								// resolved spells
+		std::vector<RE::SpellItem*> spellFormsNot;							// resolved spells to avoid
+		std::vector<RE::TESBoundObject*> hasItemForms;						// resolved items
+		std::vector<RE::TESBoundObject*> hasItemFormsNot;					// resolved items to avoid
 		std::vector<LevelCondition> level; 									// level conditions, e.g. [">= 10"]
 		std::vector<LevelCondition> levelNot; 								// level conditions to avoid, e.g. {"<", 5}
 		std::vector<ActorValueCondition> actorValue; 						// actor value conditions, e.g. ["Health >= 50.0"]
@@ -226,6 +323,100 @@ namespace OIF
 		std::unordered_set<std::string> requiredDLLsNot; 					// DLLs to avoid
 	};
 
+	enum class FilterPredicate : std::uint8_t {
+		kObjectIdentifiers,													// formTypes/formIDs/formLists/keywords, OR-ed together
+		kFormTypesNot, kFormIDsNot, kFormListsNot, kKeywordsNot,
+		kQuestItemStatus, kLockLevel, kLockLevelNot, kIsStacked, kIsInterior, kIsInitiallyDisabled,
+		kTime, kLocation, kWeather, kPosition, kIsFirstPerson, kIsThirdPerson,
+		kPerks, kPerksNot, kSpells, kSpellsNot, kHasItem, kHasItemNot,
+		kLevel, kLevelNot, kActorValue, kActorValueNot, kActorKeywords, kActorKeywordsNot, kActorRaces, kActorRacesNot,
+		kIsSneaking, kIsSwimming, kIsInCombat, kIsMounted, kIsSprinting, kIsWeaponDrawn,
+		kDestructionStage, kAllowProjectiles, kWeaponsTypes, kWeaponsTypesNot, kWeapons, kWeaponsNot,	// hit-only predicates start here
+		kWeaponsKeywords, kWeaponsKeywordsNot, kProjectiles, kProjectilesNot,
+		kAttackTypes, kAttackTypesNot, kDeliveryTypes, kDeliveryTypesNot, kIsDualCasting,			// hit-only predicates end here
+		kNearby, kNearbyNot,
+		kTotal
+	};
+
+	inline constexpr bool IsHitPredicate(FilterPredicate p) {
+		return p >= FilterPredicate::kDestructionStage && p <= FilterPredicate::kIsDualCasting;
+	}
+
+	// Predicates that only depend on the target reference and the rule's formlists, their OnUpdate results are cached per reference.
+	// Quest item status is left out: quests fill and clear aliases without touching anything the cache stamps
+	inline constexpr bool IsStaticPredicate(FilterPredicate p) {
+		switch (p) {
+			case FilterPredicate::kObjectIdentifiers:
+			case FilterPredicate::kFormTypesNot:
+			case FilterPredicate::kFormIDsNot:
+			case FilterPredicate::kFormListsNot:
+			case FilterPredicate::kKeywordsNot:
+			case FilterPredicate::kLockLevel:
+			case FilterPredicate::kLockLevelNot:
+			case FilterPredicate::kIsInitiallyDisabled:
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	struct KeywordMask {
+		std::vector<std::pair<std::uint32_t, std::uint64_t>> words;			// (word index, bits) of every non-empty word
+	};
+
+	struct KeywordIndex {
+		std::unordered_map<const RE::BGSKeyword*, std::uint32_t> bits;		// every keyword referenced by a rule -> dense bit index
+		std::uint32_t words{ 0 };											// 64-bit words needed to hold all bits
+
+		void Add(const std::set<RE::BGSKeyword*>& keywords);
+		KeywordMask MakeMask(const std::set<RE::BGSKeyword*>& keywords) const;
+	};
+
+	class KeywordSetCache
+	{
+	public:
+		// True if the form has any keyword of the mask, the form's bitset is built on first sight
+		bool HasAny(const KeywordIndex& index, const RE::BGSKeywordForm* form, const KeywordMask& mask);
+
+	private:
+		struct Entry {
+			RE::BGSKeyword** keywords{ nullptr };							// keyword array the bitset was built from
+			std::uint32_t count{ 0 };										// keyword count the bitset was built from
+			std::vector<std::uint64_t> bits;								// the form's keywords as dense bits
+		};
+
+		std::shared_mutex _mutex;
+		std::unordered_map<const RE::BGSKeywordForm*, Entry> _entries;
+	};
+
+	struct CompiledFilter {
+		std::vector<FilterPredicate> predicates;							// predicates the filter actually uses, cheapest first
+		bool hasDynamicFormList = false;									// a formLists entry uses index -2 and must always be scanned
+		bool earlyChance = false;											// chance roll is independent of counters and timers, roll it before predicates
+
+		KeywordMask keywords;												// dense masks of the keyword filters, built with the ruleset's KeywordIndex
+		KeywordMask keywordsNot;
+		KeywordMask weaponsKeywords;
+		KeywordMask weaponsKeywordsNot;
+		KeywordMask actorKeywords;
+		KeywordMask actorKeywordsNot;
+	};
+
+	// Filters are evaluated and reordered on the game thread only, so the statistics are plain counters
+	struct PredicateStats {
+		std::uint64_t evaluated{ 0 };										// number of times the predicate ran
+		std::uint64_t rejected{ 0 };										// number of times the predicate rejected the rule
+		std::uint64_t sampledCost{ 0 };										// accumulated nanoseconds over sampled evaluations
+		std::uint64_t sampled{ 0 };											// number of sampled evaluations
+	};
+
+	struct AdaptiveFilterOrder {
+		std::unique_ptr<PredicateStats[]> stats;							// statistics per compiled predicate slot
+		std::uint64_t evaluations{ 0 };										// number of MatchFilter calls for the rule
+		std::unique_ptr<std::uint8_t[]> orders;								// two orders of compiled predicate slots, a reorder writes the one not in use
+		const std::uint8_t* order{ nullptr };								// current evaluation order, points into orders
+	};
+
 
 //███████╗███████╗███████╗███████╗░█████╗░████████╗░██████╗
 //██╔════╝██╔════╝██╔════╝██╔════╝██╔══██╗╚══██╔══╝██╔════╝
@@ -414,21 +605,81 @@ namespace OIF
 		// Hit-specific context
 		RE::TESForm* attackSource{ nullptr };
 		RE::TESForm* projectileSource{ nullptr };
-		std::string weaponType;
-		std::string attackType;
-		std::string deliveryType;
+		WeaponType weaponType{ WeaponType::Other };
+		AttackType attackType{ AttackType::Regular };
+		DeliveryType deliveryType{ DeliveryType::None };
 		bool isHitEvent{ false };
 
 		// Additional context
 		RE::TESWeather* weather{ nullptr };
 		std::int32_t destructionStage{ -1 };
+
+		// Handles for work deferred past the current task, filled by CaptureHandles
+		RE::RefHandle sourceHandle{ 0 };
+		RE::RefHandle targetHandle{ 0 };
+
+		void CaptureHandles() {
+			sourceHandle = source ? source->CreateRefHandle().native_handle() : 0;
+			targetHandle = target ? target->CreateRefHandle().native_handle() : 0;
+		}
+
+		// Re-resolves source and target from their handles, references unloaded in the meantime become null
+		void ResolveHandles() {
+			RE::NiPointer<RE::TESObjectREFR> ref;
+			if (sourceHandle) {
+				source = RE::TESObjectREFR::LookupByHandle(sourceHandle, ref) && ref ? ref->As<RE::Actor>() : nullptr;
+			}
+			if (targetHandle) {
+				target = RE::TESObjectREFR::LookupByHandle(targetHandle, ref) && ref ? ref.get() : nullptr;
+			}
+		}
+	};
+
+	static_assert(std::is_trivially_copyable_v<RuleContext>, "RuleContext is copied into tasks and timers by value");
+
+	struct WorldStateSnapshot {
+		enum Part : std::uint8_t {
+			kCalendar = 1 << 0,
+			kSky = 1 << 1,
+			kCamera = 1 << 2,
+			kPlayer = 1 << 3
+		};
+
+		std::uint64_t frame{ ~0ull };										// frame the snapshot was taken in
+		std::uint8_t built{ 0 };											// parts already captured this frame
+
+		// Calendar
+		bool calendarValid = false;
+		float hour{ 0.0f };
+		float minute{ 0.0f };
+		float day{ 0.0f };
+		float month{ 0.0f };
+		float year{ 0.0f };
+		float dayOfWeek{ 0.0f };
+		float gameTime{ 0.0f };
+
+		// Sky
+		bool playerInInterior = false;										// weather filters are skipped indoors
+		RE::FormID weatherID{ 0 };											// 0 - weather data unavailable
+
+		// Camera
+		bool cameraValid = false;
+		bool isFirstPerson = false;
+		bool isThirdPerson = false;
+
+		// Player
+		bool playerValid = false;
+		RE::NiPoint3 playerCenter{ 0.0f, 0.0f, 0.0f };
+
+		void Build(std::uint8_t parts);
 	};
 
 	struct Rule {
 		std::vector<EventType> events;
 		Filter filter;
 		std::vector<Effect> effects;
-		int dynamicIndex{ 0 };
+		CompiledFilter compiled;											// filter compiled at load time
+		std::uint32_t stableID{ 0 };										// hash of the source file and rule body, identifies saved counters across load order changes
 	};
 
 	struct Key {
@@ -441,10 +692,111 @@ namespace OIF
 		}
 	};
 
-	struct UpdateFilter {
+	// Open-addressing (linear probing) counter table keyed on (source, target) packed into 64 bits plus the rule
+	class CounterTable
+	{
+	public:
+		struct Entry {
+			std::uint64_t refs{ 0 };																// sourceID << 32 | targetID
+			std::uint16_t rule{ 0 };																// rule the counter belongs to
+			bool used{ false };
+			std::uint32_t value{ 0 };																// counter value
+			std::uint32_t touched{ 0 };																// Now() of the last access
+		};
+
+		// Seconds since the plugin started, used for last-touched stamps
+		static std::uint32_t Now();
+
+		// Returns the counter for key, inserting a zero counter if it is missing
+		std::uint32_t& Touch(const Key& key, std::uint32_t now);
+		void Set(const Key& key, std::uint32_t value, std::uint32_t now);
+		void Clear();
+
+		// Examines up to slotBudget slots, dropping zero counters, counters older than maxAge (0 - never)
+		// and, once the table is close to its cap, counters of references in detached cells
+		std::size_t Maintain(std::uint32_t now, std::uint32_t maxAge, std::size_t slotBudget);
+
+		// evictLive - false keeps every nonzero counter once the cap is reached, the table then grows past it with a warning
+		void SetMemoryCap(std::size_t bytes, bool evictLive = true);
+		std::size_t Size() const { return _size; }
+		std::size_t MemoryUsage() const { return _slots.size() * sizeof(Entry); }
+
+		template <class F>
+		void ForEach(F&& func) const {
+			for (const auto& entry : _slots) {
+				if (entry.used) func(Key{ static_cast<std::uint32_t>(entry.refs >> 32), static_cast<std::uint32_t>(entry.refs), entry.rule }, entry.value);
+			}
+		}
+
+	private:
+		static std::uint64_t Pack(const Key& key) { return (static_cast<std::uint64_t>(key.sourceID) << 32) | key.targetID; }
+		static std::size_t Hash(std::uint64_t refs, std::uint16_t rule);
+		static bool IsDetached(const Entry& entry);
+
+		std::size_t Find(std::uint64_t refs, std::uint16_t rule) const;							// slot index or npos
+		void Grow();
+		void EraseSlot(std::size_t slot);
+		void EvictOne(std::uint32_t now);
+
+		static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+		static constexpr std::size_t kEvictWindow = 32;												// slots considered when the cap forces an eviction
+
+		std::vector<Entry> _slots;
+		std::size_t _size{ 0 };
+		std::size_t _hand{ 0 };																		// maintenance position, advances across calls
+		std::size_t _maxEntries{ 0 };																// 0 - no cap
+		bool _evictLive{ true };																	// the cap may drop nonzero counters
+		bool _capWarned{ false };
+	};
+
+	struct EventRuleIndex {
+		std::vector<std::size_t> rules;																// every rule registered for the event
+		std::unordered_map<RE::FormID, std::vector<std::size_t>> byFormID;						// rules naming the base FormID in formIDs
+		std::unordered_map<RE::FormType, std::vector<std::size_t>> byFormType;					// rules naming the base form type in formTypes
+		std::unordered_map<RE::BGSKeyword*, std::vector<std::size_t>> byKeyword;				// rules naming the keyword in keywords
+		std::vector<std::size_t> byFormList;														// rules with formLists, membership can change at runtime
+		std::vector<std::size_t> wildcard;															// rules without object identifiers, always candidates
+
+		void Clear() {
+			rules.clear();
+			byFormID.clear();
+			byFormType.clear();
+			byKeyword.clear();
+			byFormList.clear();
+			wildcard.clear();
+		}
+	};
+
+	class FormListCache
+	{
+	public:
+		static FormListCache* GetSingleton();
+
+		// Index of the first occurrence of formID in list->forms, -1 if it is not there
+		int IndexOf(const RE::BGSListForm* list, RE::FormID formID);
+		bool Contains(const RE::BGSListForm* list, RE::FormID formID) { return IndexOf(list, formID) >= 0; }
+		void Clear();
+
+	private:
+		struct Entry {
+			const void* data{ nullptr };															// forms storage the index was built from
+			std::uint32_t size{ 0 };																// forms count the index was built from
+			std::uint32_t scriptAdded{ 0 };															// script-added form count the index was built from
+			std::unordered_map<RE::FormID, int> indices;											// FormID -> first index in forms
+		};
+
+		static bool IsCurrent(const Entry& entry, const RE::BGSListForm* list);
+
+		std::shared_mutex _mutex;
+		std::unordered_map<const RE::BGSListForm*, Entry> _entries;
+	};
+
+	// Union of the object identifiers of one event's rules, rejects references none of them can match before a context is built
+	struct EventPrefilter {
+		bool matchAll{ true };																		// set for events without a prefilter and events with wildcard rules
 		std::unordered_set<RE::FormType> formTypes;
 		std::unordered_set<RE::FormID> formIDs;
-		std::unordered_set<RE::FormID> formLists;
+		std::vector<RE::BGSListForm*> formLists;
 		std::unordered_set<RE::BGSKeyword*> keywords;
 		
 		bool IsEmpty() const {
@@ -452,11 +804,11 @@ namespace OIF
 		}
 		
 		bool Matches(RE::TESObjectREFR* ref) const {
+			if (matchAll) return true;
 			if (!ref || !ref->GetBaseObject()) return false;
 			
 			auto* baseObj = ref->GetBaseObject();
 
-			if (IsEmpty()) return true;
 			bool hasMatch = false;
 
 			if (!formTypes.empty()) {
@@ -472,16 +824,11 @@ namespace OIF
 			}
 
 			if (!hasMatch && !formLists.empty()) {
-				for (const auto& formID : formLists) {
-					auto* list = RE::TESForm::LookupByID<RE::BGSListForm>(formID);
-					if (list) {
-						for (auto* listItem : list->forms) {
-							if (listItem && listItem->GetFormID() == baseObj->GetFormID()) {
-								hasMatch = true;
-								break;
-							}
-						}
-						if (hasMatch) break;
+				auto* cache = FormListCache::GetSingleton();
+				for (auto* list : formLists) {
+					if (cache->Contains(list, baseObj->GetFormID())) {
+						hasMatch = true;
+						break;
 					}
 				}
 			}
@@ -502,6 +849,95 @@ namespace OIF
 	};
 	
 
+	class StaticMatchCache
+	{
+	public:
+		enum Result : std::uint8_t { kUnknown, kPass, kFail };
+
+		// Assigns every OnUpdate rule a result slot, and a stamp slot if it has formlists; other rules are never cached
+		void SetRules(const std::vector<Rule>& rules, std::span<const std::size_t> updateRules);
+
+		// listStamp - FormListStamp of the rule's filter, a result computed against other formlist contents is unknown
+		Result Get(RE::TESObjectREFR* ref, std::size_t ruleIdx, std::uint64_t listStamp);
+		void Set(RE::TESObjectREFR* ref, std::size_t ruleIdx, std::uint64_t listStamp, bool passed);
+		void Forget(RE::FormID refID);
+
+		// Changes whenever a formlist of the filter is resized, reallocated or gains script-added forms, 0 without formlists
+		static std::uint64_t FormListStamp(const Filter& filter);
+
+	private:
+		struct Entry {
+			RE::TESBoundObject* base{ nullptr };													// reference state the results were computed for
+			std::uint32_t formFlags{ 0 };
+			RE::LOCK_LEVEL lockLevel{ RE::LOCK_LEVEL::kUnlocked };
+			bool locked{ false };
+			std::vector<Result> results;															// static predicate result per OnUpdate rule slot
+			std::vector<std::uint64_t> listStamps;													// formlist stamp per stamp slot, only rules with formlists have one
+			bool referenced{ false };																// read since the clock hand last passed
+		};
+
+		// References are forgotten on cell detach; the cap only bounds sweeps over areas that never detach
+		static constexpr std::size_t kMaxEntries = 8192;
+		static constexpr std::uint32_t kNoSlot = ~0u;
+
+		static bool IsCurrent(const Entry& entry, RE::TESObjectREFR* ref);
+		static void Stamp(Entry& entry, RE::TESObjectREFR* ref);
+		void EvictOne();
+
+		std::mutex _mutex;
+		std::unordered_map<RE::FormID, Entry> _entries;
+		std::vector<RE::FormID> _clock;																// eviction ring, may hold forgotten IDs
+		std::size_t _hand{ 0 };
+		std::vector<std::uint32_t> _resultSlots;													// rule index -> result slot, kNoSlot outside OnUpdate
+		std::vector<std::uint32_t> _stampSlots;														// rule index -> stamp slot, kNoSlot without formlists
+		std::size_t _resultCount{ 0 };
+		std::size_t _stampCount{ 0 };
+	};
+
+	struct LocationAncestry {
+		std::unordered_map<RE::FormID, std::uint32_t> denseIndex;									// location FormID -> dense location index
+		std::vector<std::uint32_t> offsets;															// start of every location's range in ancestors, one extra end entry
+		std::vector<RE::FormID> ancestors;															// each location followed by all of its parent locations
+		std::size_t sourceCount{ 0 };																// number of loaded locations the closure was built from
+
+		std::span<const RE::FormID> Get(const RE::BGSLocation* location) const {
+			if (!location) return {};
+			auto it = denseIndex.find(location->GetFormID());
+			if (it == denseIndex.end()) return {};
+			return { ancestors.data() + offsets[it->second], ancestors.data() + offsets[it->second + 1] };
+		}
+	};
+
+	struct RuleSet : std::enable_shared_from_this<RuleSet> {
+		std::vector<Rule> rules;																	// parsed rules in load order
+		std::array<EventRuleIndex, kEventTypeCount> eventRules;										// rule indices per event type
+		std::array<EventPrefilter, kEventTypeCount> prefilters;									// per event type, built for cell scans and per-reference sinks
+		std::unique_ptr<AdaptiveFilterOrder[]> adaptiveOrders;										// per-rule predicate statistics and order, the only runtime-mutable part
+		std::shared_ptr<const LocationAncestry> locationAncestry;									// location parent closure, shared between snapshots while location data is unchanged
+		KeywordIndex keywordIndex;																	// dense bits of every keyword referenced by the rules
+		std::unique_ptr<KeywordSetCache> keywordCache;												// per base form keyword bitsets, dropped with the snapshot
+		std::unique_ptr<StaticMatchCache> staticMatches;											// OnUpdate static predicate results per reference, dropped with the snapshot
+	};
+
+	struct RuleScratch {
+		const RuleSet* ruleSet{ nullptr };															// snapshot the rule belongs to, held by the caller
+		std::size_t ruleIdx{ 0 };																	// index of the rule in the snapshot
+		int dynamicIndex{ 0 };																		// formlist index matched by an index -2 entry
+
+		const Rule& GetRule() const { return ruleSet->rules[ruleIdx]; }
+
+		// Delayed work holds the snapshot itself, the synchronous path only borrows it
+		std::shared_ptr<const RuleSet> Retain() const { return ruleSet->shared_from_this(); }
+	};
+
+	struct RuleRolls {
+		std::uint32_t limit{ 0 };																	// rolled limit for rules with a random limit
+		std::uint32_t interactions{ 1 };															// rolled interactions for rules with random interactions
+		bool limitRolled = false;
+		bool interactionsRolled = false;
+	};
+	
+
 //███╗░░░███╗░█████╗░███╗░░██╗░█████╗░░██████╗░███████╗██████╗░
 //████╗░████║██╔══██╗████╗░██║██╔══██╗██╔════╝░██╔════╝██╔══██╗
 //██╔████╔██║███████║██╔██╗██║███████║██║░░██╗░█████╗░░██████╔╝
@@ -517,12 +953,19 @@ namespace OIF
 
 		RuleManager() = default;
 
-		void ParseJSON(const std::filesystem::path& path);
-		bool MatchFilter(const Filter& f, const RuleContext& ctx, Rule& currentRule) const;
-		void ApplyEffect(const Effect& eff, const RuleContext& ctx, Rule& currentRule) const;
+		void ParseJSON(const std::filesystem::path& path, std::vector<Rule>& rules);
+		bool MatchFilter(const Rule& rule, const RuleContext& ctx, RuleScratch& scratch) const;
+		bool MatchPredicate(FilterPredicate predicate, const Rule& rule, const RuleContext& ctx, RuleScratch& scratch) const;
+		static CompiledFilter CompileFilter(const Rule& rule);
+		static void ResolveFilterForms(Rule& rule, std::vector<RE::FormID>& unresolved);
+		static void InitAdaptiveOrders(RuleSet& ruleSet);
+		static void BuildKeywordMasks(RuleSet& ruleSet);
+		static void AssignStableIDs(RuleSet& ruleSet);
+		void RemapCounters(const RuleSet* previous, const RuleSet& next);
+		void ApplyEffect(Effect eff, const RuleContext& ctx, const RuleScratch& scratch) const;
 
 		template <typename FormT, typename DataT, typename CreateDataFunc, typename ApplyEffectFunc>
-		void ProcessEffect(const Effect& eff, const RuleContext& ctx, const Rule& currentRule, bool needsForm, CreateDataFunc createData, ApplyEffectFunc applyEffect) const {
+		void ProcessEffect(const Effect& eff, const RuleContext& ctx, const RuleScratch& scratch, bool needsForm, CreateDataFunc createData, ApplyEffectFunc applyEffect) const {
 			static thread_local std::mt19937 rng(std::random_device{}());
 			std::vector<DataT> dataList;
 			for (const auto& [form, extData] : eff.items) {
@@ -553,7 +996,7 @@ namespace OIF
 					if (idx == -3) {
 						idx = std::uniform_int_distribution<int>(0, static_cast<int>(list->forms.size()) - 1)(rng);
 					} else if (idx == -2) {
-						idx = currentRule.dynamicIndex;
+						idx = scratch.dynamicIndex;
 					}
 					if (idx == -1) {
 						for (auto* el : list->forms) {
@@ -570,6 +1013,7 @@ namespace OIF
 				// Roll for random timer if needed
 				float currentTimerValue = 0.0f;
 				std::uint32_t matchFilterRecheck = 0;
+				TimerClock timerClock = TimerClock::kRealTime;
 				if (eff.items.size() > 0) {
 					currentTimerValue = eff.items[0].second.timer.time.value;
 					if (eff.items[0].second.timer.time.useRandom) {
@@ -577,111 +1021,58 @@ namespace OIF
 						currentTimerValue = timerDist(rng);
 					}
 					matchFilterRecheck = eff.items[0].second.timer.matchFilterRecheck;
+					timerClock = eff.items[0].second.timer.clock;
 				}
 
 				if (currentTimerValue > 0.0f) {
-					static std::vector<std::future<void>> effectTimerTasks;
-					static std::mutex effectTimerMutex;
-					auto effectTimerFuture = std::async(std::launch::async, [this, dataList, ctx, applyEffect, currentTimerValue, matchFilterRecheck, &currentRule]() {
-						std::this_thread::sleep_for(std::chrono::duration<float>(currentTimerValue));
-
-						SKSE::GetTaskInterface()->AddTask([this, dataList, ctx, applyEffect, matchFilterRecheck, &currentRule]() mutable {
-							auto* target = ctx.target;
-							auto* source = ctx.source;
-							if (!target || target->IsDeleted()) return;
-							if (source && source->IsDeleted()) return;
-							if (matchFilterRecheck == 1) {
-								Rule& mutableRule = const_cast<Rule&>(currentRule);
-								if (!MatchFilter(currentRule.filter, ctx, mutableRule)) return;
-							}
-							applyEffect(ctx, dataList);
-						});
-					});
-					{
-						std::lock_guard<std::mutex> timerLock(effectTimerMutex);
-						effectTimerTasks.push_back(std::move(effectTimerFuture));
-
-						effectTimerTasks.erase(
-							std::remove_if(effectTimerTasks.begin(), effectTimerTasks.end(),
-								[](const std::future<void>& f) {
-									return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
-								}),
-							effectTimerTasks.end());
-					}
+					RuleContext deferred = ctx;
+					deferred.CaptureHandles();
+
+					Scheduler::GetSingleton()->Schedule(currentTimerValue, [this, dataList, ctx = deferred, applyEffect, matchFilterRecheck, scratch, keepAlive = scratch.Retain()]() mutable {
+						ctx.ResolveHandles();
+						auto* target = ctx.target;
+						auto* source = ctx.source;
+						if (!target || target->IsDeleted()) return;
+						if (source && source->IsDeleted()) return;
+						if (matchFilterRecheck == 1) {
+							if (!MatchFilter(scratch.GetRule(), ctx, scratch)) return;
+						}
+						applyEffect(ctx, dataList);
+					}, deferred.targetHandle, timerClock);
 				} else {
 					applyEffect(ctx, dataList);
 				}
 			}
 		}
 
-		std::map<Key, std::uint32_t> _limitCounts;
-		std::map<Key, std::uint32_t> _interactionsCounts;
+		CounterTable _limitCounts;
+		CounterTable _interactionsCounts;
+		CounterTable _updateTimers;																	// OnUpdate timer start per (source, target, rule), in milliseconds of the rule's timer clock
+		std::vector<RuleRolls> _ruleRolls;															// rolled limit/interactions values per rule of the current snapshot
+		mutable std::mutex _counterMutex;															// guards counters, timers, rolls and the hit deduplication map
 
 		std::unordered_map<RE::TESObjectREFR*, std::chrono::steady_clock::time_point> recentlyProcessedItems;
-        std::chrono::steady_clock::time_point lastCleanupTime;
+		std::deque<std::pair<RE::TESObjectREFR*, std::chrono::steady_clock::time_point>> recentlyProcessedQueue;	// insertion order, expired from the front
 
-		mutable std::vector<Rule*> updateRules;
-		mutable bool updateRulesCached = false;
+		std::atomic<std::shared_ptr<const RuleSet>> _ruleSet;										// published ruleset, swapped as a whole by LoadRules
+		std::atomic<std::uint32_t> _listenedEvents{ 0 };											// EventBit of every event type with at least one rule
+		std::mutex _loadMutex;																		// serializes concurrent LoadRules calls
+		std::mutex _reorderMutex;																	// serializes adaptive predicate reorder passes
 
-		mutable UpdateFilter cachedUpdateFilter;
-    	mutable bool updateFilterCached = false;
+		std::atomic<std::uint64_t> _frame{ 0 };													// advanced once per frame, invalidates world state snapshots
 
-		UpdateFilter BuildUpdateFilter() const {
-			UpdateFilter filter;
-			
-			std::shared_lock lock(_ruleMutex);
-			
-			for (const auto& rule : _rules) {
-				bool hasOnUpdate = std::find(rule.events.begin(), rule.events.end(), EventType::kOnUpdate) != rule.events.end();
-				if (!hasOnUpdate) continue;
-				
-				for (auto formType : rule.filter.formTypes) {
-					filter.formTypes.insert(formType);
-				}
-				
-				for (auto formID : rule.filter.formIDs) {
-					filter.formIDs.insert(formID);
-				}
-				
-				for (const auto& entry : rule.filter.formLists) {
-					auto* list = RE::TESForm::LookupByID<RE::BGSListForm>(entry.formID);
-					if (!list) continue;
-					
-					for (auto* form : list->forms) {
-						if (form) {
-							filter.formIDs.insert(form->GetFormID());
-						}
-					}
-				}
+		std::array<std::atomic<std::uint64_t>, kEventTypeCount> _eventTriggerCounts{};			// number of Trigger calls per event type
+		std::array<std::atomic<std::uint64_t>, kEventTypeCount> _eventVisitedRuleCounts{};		// number of rules visited per event type
 
-				if (!rule.filter.keywords.empty()) {
-					filter.formTypes.insert(RE::FormType::Activator);
-					filter.formTypes.insert(RE::FormType::TalkingActivator);
-					filter.formTypes.insert(RE::FormType::Weapon);
-					filter.formTypes.insert(RE::FormType::Armor);
-					filter.formTypes.insert(RE::FormType::Ammo);
-					filter.formTypes.insert(RE::FormType::Ingredient);
-					filter.formTypes.insert(RE::FormType::Misc);
-					filter.formTypes.insert(RE::FormType::Book);
-					filter.formTypes.insert(RE::FormType::Note);
-					filter.formTypes.insert(RE::FormType::Scroll);
-					filter.formTypes.insert(RE::FormType::SoulGem);
-					filter.formTypes.insert(RE::FormType::AlchemyItem);
-					filter.formTypes.insert(RE::FormType::Furniture);
-					filter.formTypes.insert(RE::FormType::Flora);
-					filter.formTypes.insert(RE::FormType::KeyMaster);
-				}
-			}
-
-			return filter;
-		}
+		static void BuildEventIndex(RuleSet& ruleSet);
+		static EventPrefilter BuildPrefilter(const RuleSet& ruleSet, EventType event);
+		static std::shared_ptr<const LocationAncestry> BuildLocationAncestry(const std::shared_ptr<const LocationAncestry>& previous);
+		void TriggerRules(const std::shared_ptr<const RuleSet>& ruleSet, const RuleContext& ctx);
+		void CollectCandidateRules(const EventRuleIndex& index, RE::TESForm* baseObj, std::vector<std::size_t>& out) const;
 
 	public:
 		static RuleManager* GetSingleton();
 
-		std::vector<Rule> _rules;
-		mutable std::shared_mutex _ruleMutex;
-
 		template <class T = RE::TESForm>
 		static T* GetFormFromIdentifier(const std::string& identifier);
 		template <class T = RE::TESForm>
@@ -689,37 +1080,41 @@ namespace OIF
 
 		void LoadRules();
 		void Trigger(const RuleContext& ctx);
+		void TriggerBatch(std::span<const RuleContext> batch);
+		// Bounded maintenance of counters, timers and hit deduplication, called once per frame
 		void CleanupCounters();
+		void UpdatePredicateOrder();
+		void ForgetStaticMatches(RE::FormID refID);
+
+		void AdvanceFrame() { _frame.fetch_add(1, std::memory_order_relaxed); }
+
+		// Returns this thread's world state for the current frame with the requested parts captured
+		const WorldStateSnapshot& GetWorldState(std::uint8_t parts) const;
 		
 		void ResetInteractionCounts();
 		void OnSave(SKSE::SerializationInterface* intf);
 		void OnLoad(SKSE::SerializationInterface* intf);
 		void InitSerialization();
 
-		void InvalidateUpdateCache() { 
-			updateRulesCached = false; 
-			updateFilterCached = false;
+		// Returns the current ruleset; the snapshot stays valid for as long as the caller holds it
+		std::shared_ptr<const RuleSet> GetRuleSet() const {
+			return _ruleSet.load(std::memory_order_acquire);
 		}
-    
-		const std::vector<Rule*>& GetUpdateRules() {
-			if (!updateRulesCached) {
-				updateRules.clear();
-				for (auto& rule : _rules) {
-					if (std::find(rule.events.begin(), rule.events.end(), EventType::kOnUpdate) != rule.events.end()) {
-						updateRules.push_back(&rule);
-					}
-				}
-				updateRulesCached = true;
-			}
-			return updateRules;
+
+		// One relaxed load, lets sinks and hooks drop events no loaded rule listens to before doing any work
+		bool HasRulesFor(std::uint32_t eventMask) const { return (_listenedEvents.load(std::memory_order_relaxed) & eventMask) != 0; }
+		bool HasRulesFor(EventType event) const { return HasRulesFor(EventBit(event)); }
+
+		std::uint64_t GetTriggerCount(EventType event) const {
+			auto idx = static_cast<std::size_t>(event);
+			return idx < kEventTypeCount ? _eventTriggerCounts[idx].load(std::memory_order_relaxed) : 0;
 		}
 
-		const UpdateFilter& GetUpdateFilter() const {
-			if (!updateFilterCached) {
-				cachedUpdateFilter = BuildUpdateFilter();
-				updateFilterCached = true;
-			}
-			return cachedUpdateFilter;
+		std::uint64_t GetVisitedRuleCount(EventType event) const {
+			auto idx = static_cast<std::size_t>(event);
+			return idx < kEventTypeCount ? _eventVisitedRuleCounts[idx].load(std::memory_order_relaxed) : 0;
 		}
+
+		void LogEventStatistics() const;
 	};
 }
@@ -0,0 +1,80 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+
+namespace OIF
+{
+	enum class TimerClock : std::uint8_t {
+		kRealTime,																			// wall clock, keeps running in menus and loading screens
+		kGameTime																			// simulated time, advanced by the player update only while the game runs
+	};
+
+	// Real-time delays wait in a min-heap served by one worker thread that hands due tasks to the SKSE task queue in batches,
+	// game-time delays wait in a second heap drained from the player update in bounded batches
+	class Scheduler {
+
+	private:
+		Scheduler(const Scheduler&) = delete;
+		Scheduler& operator=(const Scheduler&) = delete;
+
+		Scheduler() = default;
+
+	public:
+		using Task = std::function<void()>;
+		using TimerID = std::uint64_t;
+
+		static Scheduler* GetSingleton();
+
+		// Runs task on the game thread after delay seconds; with a guard handle the task is dropped once the reference is gone
+		TimerID Schedule(float delay, Task task, RE::RefHandle guard = 0, TimerClock clock = TimerClock::kRealTime);
+
+		// Advances game time by delta seconds and runs at most maxTasks due game-time tasks, the rest wait for the next frame
+		void AdvanceGameTime(float delta, std::size_t maxTasks);
+
+		// Returns false if the timer already ran or was cancelled
+		bool Cancel(TimerID id);
+		void CancelAll();
+
+		std::size_t GetPendingCount() const;
+
+		// Simulated seconds advanced so far by AdvanceGameTime
+		double GetGameTime() const;
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		struct Pending {
+			Task task;
+			RE::RefHandle guard{ 0 };														// reference the task depends on, 0 - none
+		};
+
+		template <class T>
+		struct Due {
+			T time;
+			TimerID id;
+
+			bool operator>(const Due& other) const { return time > other.time; }
+		};
+
+		template <class T>
+		using DueHeap = std::priority_queue<Due<T>, std::vector<Due<T>>, std::greater<>>;
+
+		static void RunTask(const Pending& pending);
+		void Run(std::stop_token stop);
+
+		mutable std::mutex _mutex;
+		std::condition_variable_any _wake;
+		DueHeap<Clock::time_point> _heap;													// real-time timers, cancelled entries stay until they come due
+		DueHeap<double> _gameHeap;															// game-time timers
+		double _gameTime{ 0.0 };															// simulated seconds since the plugin started
+		std::vector<Pending> _gameBatch;													// reused by AdvanceGameTime
+		std::unordered_map<TimerID, Pending> _pending;
+		TimerID _nextID{ 1 };
+		std::jthread _worker;																// started by the first Schedule call
+	};
+}
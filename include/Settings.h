@@ -0,0 +1,34 @@
+#pragma once
+
+namespace OIF
+{
+	// Optional framework settings read from Data/SKSE/Plugins/ObjectImpactFramework.json
+	class Settings {
+
+	private:
+		Settings(const Settings&) = delete;
+		Settings& operator=(const Settings&) = delete;
+
+		Settings() = default;
+
+	public:
+		static Settings* GetSingleton();
+
+		void Load();
+
+		// Filter evaluation
+		bool freezePredicateOrder{ false };									// keep the load-time cost order of filter predicates (for benchmarking)
+		float predicateReorderInterval{ 10.0f };							// seconds between adaptive predicate reorder passes
+		std::uint32_t predicateReorderMinSamples{ 256 };					// filter evaluations a rule needs before its order adapts
+
+		// Limit / interaction counters
+		std::uint32_t counterMemoryCapKB{ 1024 };							// memory cap of each counter table, limit counters only warn (0 - unbounded)
+		float interactionCounterMaxAge{ 600.0f };							// seconds an untouched interaction counter is kept (0 - forever)
+
+		// Timers
+		std::uint32_t gameTimerTasksPerFrame{ 32 };							// game-time timers fired per frame at most, the rest carry over
+
+		// Effects
+		float effectBudgetMs{ 2.0f };										// milliseconds per frame spent running queued effects
+	};
+}
@@ -0,0 +1,89 @@
+#include "CounterCodec.h"
+#include <algorithm>
+#include <tuple>
+
+namespace OIF::CounterCodec {
+
+// ╔════════════════════════════════════╗
+// ║           COUNTER CODEC            ║
+// ╚════════════════════════════════════╝
+
+	static void WriteVarint(std::vector<std::uint8_t>& out, std::uint32_t value) {
+		while (value >= 0x80) {
+			out.push_back(static_cast<std::uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+		out.push_back(static_cast<std::uint8_t>(value));
+	}
+
+	static bool ReadVarint(std::span<const std::uint8_t> data, std::size_t& pos, std::uint32_t& value) {
+		value = 0;
+		for (std::uint32_t shift = 0; shift < 35; shift += 7) {
+			if (pos >= data.size()) return false;
+			const std::uint8_t byte = data[pos++];
+			value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+			if (!(byte & 0x80)) return true;
+		}
+		return false;
+	}
+
+	std::vector<std::uint8_t> Encode(std::vector<SavedCount>& counts) {
+		std::ranges::sort(counts, [](const SavedCount& a, const SavedCount& b) {
+			return std::tie(a.ruleID, a.sourceID, a.targetID) < std::tie(b.ruleID, b.sourceID, b.targetID);
+		});
+
+		// Sorted keys are written as deltas: a field changes -> its delta, the fields below it in full
+		std::vector<std::uint8_t> out;
+		out.reserve(counts.size() * 6 + 5);
+		WriteVarint(out, static_cast<std::uint32_t>(counts.size()));
+
+		SavedCount prev{ 0, 0, 0, 0 };
+		for (const auto& c : counts) {
+			if (c.ruleID != prev.ruleID) {
+				WriteVarint(out, c.ruleID - prev.ruleID);
+				WriteVarint(out, c.sourceID);
+				WriteVarint(out, c.targetID);
+			} else if (c.sourceID != prev.sourceID) {
+				WriteVarint(out, 0);
+				WriteVarint(out, c.sourceID - prev.sourceID);
+				WriteVarint(out, c.targetID);
+			} else {
+				WriteVarint(out, 0);
+				WriteVarint(out, 0);
+				WriteVarint(out, c.targetID - prev.targetID);
+			}
+			WriteVarint(out, c.value);
+			prev = c;
+		}
+		return out;
+	}
+
+	bool Decode(std::span<const std::uint8_t> data, std::vector<SavedCount>& out) {
+		std::size_t pos = 0;
+		std::uint32_t count = 0;
+		if (!ReadVarint(data, pos, count) || count > data.size() / 4) return false;		// every entry takes at least 4 bytes
+
+		out.clear();
+		out.reserve(count);
+
+		SavedCount cur{ 0, 0, 0, 0 };
+		for (std::uint32_t i = 0; i < count; ++i) {
+			std::uint32_t ruleDelta, sourceField, targetField;
+			if (!ReadVarint(data, pos, ruleDelta) || !ReadVarint(data, pos, sourceField) || !ReadVarint(data, pos, targetField)) return false;
+
+			if (ruleDelta) {
+				cur.ruleID += ruleDelta;
+				cur.sourceID = sourceField;
+				cur.targetID = targetField;
+			} else if (sourceField) {
+				cur.sourceID += sourceField;
+				cur.targetID = targetField;
+			} else {
+				cur.targetID += targetField;
+			}
+			if (!ReadVarint(data, pos, cur.value)) return false;
+			out.push_back(cur);
+		}
+		return pos == data.size();
+	}
+}
@@ -0,0 +1,154 @@
+#include "EffectQueue.h"
+
+namespace OIF {
+
+// ╔════════════════════════════════════╗
+// ║            EFFECT QUEUE            ║
+// ╚════════════════════════════════════╝
+
+	EffectQueue* EffectQueue::GetSingleton() {
+		static EffectQueue inst;
+		return &inst;
+	}
+
+	void EffectQueue::Push(EffectPriority priority, Job job)
+	{
+		if (!job) return;
+		Enqueue(priority, Entry{ std::move(job) });
+	}
+
+	void EffectQueue::Push(EffectPriority priority, Job job, const CoalesceKey& key, std::vector<std::uint32_t> counts)
+	{
+		if (!job) return;
+		Enqueue(priority, Entry{ std::move(job), 1, true, key, std::move(counts) });
+	}
+
+	bool EffectQueue::MergeCounts(std::vector<std::uint32_t>& into, std::span<const std::uint32_t> from)
+	{
+		if (into.size() != from.size()) return false;
+		for (std::size_t i = 0; i < into.size(); ++i) {
+			into[i] += from[i];
+		}
+		return true;
+	}
+
+	void EffectQueue::Enqueue(EffectPriority priority, Entry entry)
+	{
+		const auto idx = std::min(static_cast<std::size_t>(priority), kPriorityCount - 1);
+
+		{
+			std::lock_guard lock(_mutex);
+			if (entry.coalescable) {
+				if (auto it = _queuedByKey.find(entry.key); it != _queuedByKey.end()) {
+					if (MergeCounts(it->second->counts, entry.counts)) {
+						++it->second->repeats;
+						++_mergedSinceDrain;
+						++_mergedSinceReport;
+						return;
+					}
+					entry.coalescable = false;												// a hash collision between different items, run it on its own
+				}
+			}
+
+			auto& queued = _jobs[idx].emplace_back(std::move(entry));
+			if (queued.coalescable) _queuedByKey.emplace(queued.key, &queued);
+			_peakDepth = std::max(_peakDepth, ++_depth);
+		}
+		_frameDriver.Request();
+	}
+
+	void EffectQueue::RunFrame(float budgetMs)
+	{
+		Drain(budgetMs);
+	}
+
+	bool EffectQueue::DrainWhilePaused()
+	{
+		Drain(Settings::GetSingleton()->effectBudgetMs);
+		return GetDepth() > 0;
+	}
+
+	void EffectQueue::Drain(float budgetMs)
+	{
+		const auto start = Clock::now();
+		const auto budget = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float, std::milli>(std::max(budgetMs, 0.0f)));
+
+		std::size_t executed = 0;
+		while (true) {
+			Job job;
+			std::uint32_t repeats = 1;
+			std::vector<std::uint32_t> counts;
+			{
+				std::lock_guard lock(_mutex);
+				if (_depth == 0) break;
+				if (executed > 0 && Clock::now() - start >= budget) break;
+
+				for (auto& queue : _jobs) {
+					if (queue.empty()) continue;
+					auto& front = queue.front();
+					if (front.coalescable) _queuedByKey.erase(front.key);
+					job = std::move(front.job);
+					repeats = front.repeats;
+					counts = std::move(front.counts);
+					queue.pop_front();
+					--_depth;
+					break;
+				}
+			}
+
+			// Jobs may queue further effects, so they run without the lock
+			try {
+				job(repeats, counts);
+			} catch (const std::exception& e) {
+				logger::error("Effect job failed: {}", e.what());
+			}
+			++executed;
+		}
+
+		if (executed == 0) return;
+
+		const float drainMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+		std::lock_guard lock(_mutex);
+		_lastStats = FrameStats{ executed, _depth, _mergedSinceDrain, drainMs };
+		_mergedSinceDrain = 0;
+		_peakDrainMs = std::max(_peakDrainMs, drainMs);
+		if (_depth > 0) ++_carriedFrames;
+	}
+
+	void EffectQueue::Clear()
+	{
+		std::lock_guard lock(_mutex);
+		for (auto& queue : _jobs) {
+			queue.clear();
+		}
+		_queuedByKey.clear();
+		_depth = 0;
+	}
+
+	std::size_t EffectQueue::GetDepth() const
+	{
+		std::lock_guard lock(_mutex);
+		return _depth;
+	}
+
+	EffectQueue::FrameStats EffectQueue::GetLastFrameStats() const
+	{
+		std::lock_guard lock(_mutex);
+		return _lastStats;
+	}
+
+	void EffectQueue::ReportMetrics()
+	{
+		std::lock_guard lock(_mutex);
+		if (_peakDepth == 0 && _mergedSinceReport == 0) return;
+
+		logger::debug("Effect queue: peak depth {}, peak drain {:.2f} ms, {} frames carried jobs over, {} duplicates merged, {} queued now",
+			_peakDepth, _peakDrainMs, _carriedFrames, _mergedSinceReport, _depth);
+
+		_peakDepth = _depth;
+		_peakDrainMs = 0.0f;
+		_carriedFrames = 0;
+		_mergedSinceReport = 0;
+	}
+}
@@ -830,30 +830,16 @@ namespace OIF::Effects
 
 		PlayIdleOnActor(ctx.source, data.string);
 
-		static std::vector<std::future<void>> runningTasks;
-		static std::mutex tasksMutex;
-
-		auto future = std::async(std::launch::async, [actor = ctx.source, duration = data.duration]() {
-			std::this_thread::sleep_for(std::chrono::duration<float>(duration));
-
-			SKSE::GetTaskInterface()->AddTask([actor]() {
-				if (actor && !actor->IsDeleted() && !actor->IsDead()) {
-					PlayIdleOnActor(actor, "IdleStop");
-				}
-			});
-		});
-
-		{
-			std::lock_guard<std::mutex> lock(tasksMutex);
-			runningTasks.push_back(std::move(future));
-
-			runningTasks.erase(
-				std::remove_if(runningTasks.begin(), runningTasks.end(),
-					[](const std::future<void>& f) {
-						return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
-					}),
-				runningTasks.end());
-		}
+		const RE::RefHandle actorHandle = ctx.source->CreateRefHandle().native_handle();
+		Scheduler::GetSingleton()->Schedule(data.duration, [actorHandle]() {
+			RE::NiPointer<RE::TESObjectREFR> ref;
+			if (!RE::TESObjectREFR::LookupByHandle(actorHandle, ref) || !ref) return;
+
+			auto* actor = ref->As<RE::Actor>();
+			if (actor && !actor->IsDeleted() && !actor->IsDead()) {
+				PlayIdleOnActor(actor, "IdleStop");
+			}
+		}, actorHandle);
 	}
 
 	void UnlockItem(const RuleContext& ctx)
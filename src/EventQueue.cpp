@@ -0,0 +1,124 @@
+#include <bit>
+#include "EventQueue.h"
+
+namespace OIF {
+
+// ╔════════════════════════════════════╗
+// ║            EVENT QUEUE             ║
+// ╚════════════════════════════════════╝
+
+	std::size_t EventRecordHash::operator()(const EventRecord& record) const
+	{
+		std::uint64_t h = (static_cast<std::uint64_t>(record.origin) << 8) | static_cast<std::uint64_t>(record.event);
+		auto mix = [&h](std::uint64_t value) {
+			h ^= value + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+		};
+		mix((static_cast<std::uint64_t>(record.source) << 32) | record.target);
+		mix((static_cast<std::uint64_t>(record.form) << 32) | record.extra);
+		mix(static_cast<std::uint32_t>(record.stage));
+		for (float v : record.position) {
+			mix(std::bit_cast<std::uint32_t>(v));
+		}
+		mix(std::bit_cast<std::uint32_t>(record.radius));
+		return static_cast<std::size_t>(h);
+	}
+
+	EventQueue* EventQueue::GetSingleton() {
+		static EventQueue inst;
+		return &inst;
+	}
+
+	void EventQueue::Push(const EventRecord& record)
+	{
+		if (!_ring.TryPush(record)) {
+			std::lock_guard lock(_overflowMutex);
+			_overflow.push_back(record);
+			_hasOverflow.store(true, std::memory_order_release);
+			_overflowSinceReport.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		_frameDriver.Request();
+	}
+
+	void EventQueue::RunFrame()
+	{
+		Drain();
+	}
+
+	bool EventQueue::DrainWhilePaused()
+	{
+		// The consumer may have queued follow-up events, one more pass picks them up
+		return Drain() > 0;
+	}
+
+	std::size_t EventQueue::Collect()
+	{
+		_drained.clear();
+		_seen.clear();
+
+		std::size_t received = 0;
+		auto keep = [&](const EventRecord& record) {
+			++received;
+			if (_seen.insert(record).second) _drained.push_back(record);
+		};
+
+		EventRecord record;
+		while (_ring.TryPop(record)) {
+			keep(record);
+		}
+
+		if (_hasOverflow.exchange(false, std::memory_order_acq_rel)) {
+			std::vector<EventRecord> overflow;
+			{
+				std::lock_guard lock(_overflowMutex);
+				overflow.swap(_overflow);
+			}
+			for (const auto& spilled : overflow) {
+				keep(spilled);
+			}
+		}
+
+		return received;
+	}
+
+	std::size_t EventQueue::Drain()
+	{
+		const std::size_t received = Collect();
+		if (received == 0) return 0;
+
+		_receivedSinceReport += received;
+		_duplicatesSinceReport += received - _drained.size();
+		_peakDrain = std::max(_peakDrain, received);
+
+		auto consumer = _consumer.load(std::memory_order_acquire);
+		if (!consumer) return received;
+
+		// Records are copied out first, the consumer may queue new events while it runs
+		try {
+			consumer(_drained);
+		} catch (const std::exception& e) {
+			logger::error("Event consumer failed: {}", e.what());
+		}
+		return received;
+	}
+
+	void EventQueue::Clear()
+	{
+		Collect();
+		_drained.clear();
+		_seen.clear();
+	}
+
+	void EventQueue::ReportMetrics()
+	{
+		const std::size_t overflow = _overflowSinceReport.exchange(0, std::memory_order_relaxed);
+		if (_receivedSinceReport == 0 && overflow == 0) return;
+
+		logger::debug("Event queue: {} events received, {} duplicates dropped, peak drain {}, {} spilled past the ring",
+			_receivedSinceReport, _duplicatesSinceReport, _peakDrain, overflow);
+
+		_receivedSinceReport = 0;
+		_duplicatesSinceReport = 0;
+		_peakDrain = 0;
+	}
+}
@@ -39,58 +39,11 @@ namespace OIF
         RE::FormType::Light
     };
 
-
-//███████╗███╗░░██╗██╗░░░██╗███╗░░░███╗░██████╗
-//██╔════╝████╗░██║██║░░░██║████╗░████║██╔════╝
-//█████╗░░██╔██╗██║██║░░░██║██╔████╔██║╚█████╗░
-//██╔══╝░░██║╚████║██║░░░██║██║╚██╔╝██║░╚═══██╗
-//███████╗██║░╚███║╚██████╔╝██║░╚═╝░██║██████╔╝
-//╚══════╝╚═╝░░╚══╝░╚═════╝░╚═╝░░░░░╚═╝╚═════╝░                                 
-
-	enum class WeaponType
-	{
-        HandToHand,
-        OneHandSword,
-        Dagger,
-        OneHandAxe,
-        OneHandMace,
-        TwoHandSword,
-        TwoHandAxe,
-        Ranged,
-        Staff,
-        Spell,
-        Scroll,
-        Shout,
-        Ability,
-        LesserPower,
-        Power,
-        Explosion,
-        Total,
-        Other
-    };
-
-    enum class AttackType {
-        Regular,
-        Power,
-        Bash,
-        Charge,
-        Rotating,
-        Continuous,
-        Constant,
-        FireAndForget,
-        IgnoreWeapon,
-        OverrideData    
-    }; 
-
-    enum class DeliveryType {
-        Self,
-        Aimed,
-        TargetActor,
-        TargetLocation,
-        Touch,
-        Total,
-        None
-    };
+	// Event types each shared source can produce
+	constexpr std::uint32_t kReleaseEvents = EventBit(EventType::kRelease) | EventBit(EventType::kThrow) | EventBit(EventType::kTelekinesis);
+	constexpr std::uint32_t kGrabReleaseEvents = EventBit(EventType::kGrab) | kReleaseEvents;
+	constexpr std::uint32_t kLandingEvents = EventBit(EventType::kThrow) | EventBit(EventType::kTelekinesis) | EventBit(EventType::kDrop);
+	constexpr std::uint32_t kCellAttachDetachEvents = EventBit(EventType::kCellAttach) | EventBit(EventType::kCellDetach) | EventBit(EventType::kOnUpdate);
 
 
 //░██████╗████████╗░█████╗░████████╗██╗░█████╗░░██████╗
@@ -160,106 +113,86 @@ namespace OIF
         return AttackType::Regular;
     }
 
-    std::string WeaponTypeToString(WeaponType weaponType) {
-        switch (weaponType) {
-            case WeaponType::HandToHand:     return "handtohand";
-            case WeaponType::OneHandSword:   return "onehandsword";
-            case WeaponType::Dagger:         return "dagger";
-            case WeaponType::OneHandAxe:     return "onehandaxe";
-            case WeaponType::OneHandMace:    return "onehandmace";
-            case WeaponType::TwoHandSword:   return "twohandsword";
-            case WeaponType::TwoHandAxe:     return "twohandaxe";
-            case WeaponType::Ranged:         return "ranged";
-            case WeaponType::Staff:          return "staff";
-            case WeaponType::Spell:          return "spell";
-            case WeaponType::Scroll:         return "scroll";
-            case WeaponType::Shout:          return "shout";
-            case WeaponType::Ability:        return "ability";
-            case WeaponType::LesserPower:    return "lesserpower";
-            case WeaponType::Power:          return "power";
-            case WeaponType::Explosion:      return "explosion";
-            case WeaponType::Total:          return "total";
-            default:                         return "other";
-        }
-    }
-    
-    std::string AttackTypeToString(AttackType attackType) {
-        switch (attackType) {
-            case AttackType::Regular:        return "regular";
-            case AttackType::Power:          return "power";
-            case AttackType::Bash:           return "bash";
-            case AttackType::Charge:         return "charge";
-            case AttackType::Rotating:       return "rotating";
-            case AttackType::Continuous:     return "continuous";
-            case AttackType::Constant:       return "constant";
-            case AttackType::FireAndForget:  return "fireandforget";
-            case AttackType::IgnoreWeapon:   return "ignoreweapon";
-            case AttackType::OverrideData:   return "overridedata";
-            default:                         return "regular";
-        }
-    }
-
-    std::string DeliveryTypeToString(DeliveryType delivery) {
-        switch (delivery) {
-            case DeliveryType::Self:           return "self";
-            case DeliveryType::Aimed:          return "aimed";
-            case DeliveryType::TargetActor:    return "targetactor";
-            case DeliveryType::TargetLocation: return "targetlocation";
-            case DeliveryType::Touch:          return "touch";
-            case DeliveryType::Total:          return "total";
-            case DeliveryType::None:           return "none";
-            default:                           return "none";
-        }
+    RE::hkpRigidBody* GetRigidBody(RE::TESObjectREFR* ref) {
+        auto threedimObj = ref ? ref->Get3D() : nullptr;
+        if (!threedimObj) return nullptr;
+        auto collisionObj = threedimObj->GetCollisionObject();
+        if (!collisionObj) return nullptr;
+        auto bhkBody = collisionObj->GetRigidBody();
+        if (!bhkBody) return nullptr;
+        return bhkBody->GetRigidBody();
     }
 
-    void ScanCell(RE::Actor* source, std::vector<RE::TESObjectREFR*>* foundObjects = nullptr, bool triggerEvents = false, 
-				  EventType eventType = EventType::kNone, RE::TESWeather* weather = nullptr, const UpdateFilter* updateFilter = nullptr)
+    // Appends a context for every reference in the source's cell that passes the event's prefilter
+    static void CollectCellContexts(RE::Actor* source, EventType eventType, RE::TESWeather* weather, std::vector<RuleContext>& batch)
     {
 		if (!EventSinkBase::IsActorSafe(source)) return;
 
         auto* cell = source->GetParentCell();
         if (!cell) return;
 
-        std::size_t processedCount = 0;
-        std::size_t skippedCount = 0;
+        const auto evIdx = static_cast<std::size_t>(eventType);
+        if (evIdx >= kEventTypeCount) return;
+
+        // Hold the snapshot so the event's prefilter stays valid during the scan
+        auto ruleSet = RuleManager::GetSingleton()->GetRuleSet();
+        if (!ruleSet || ruleSet->eventRules[evIdx].rules.empty()) return;
+        const auto& prefilter = ruleSet->prefilters[evIdx];
 
         cell->ForEachReference([&](RE::TESObjectREFR* ref) -> RE::BSContainer::ForEachResult {
             if (!EventSinkBase::IsItemSafe(ref)) return RE::BSContainer::ForEachResult::kContinue;
+            if (!prefilter.Matches(ref)) return RE::BSContainer::ForEachResult::kContinue;
 
-            if (triggerEvents) {
-                if (eventType == EventType::kOnUpdate && updateFilter && !updateFilter->IsEmpty()) {
-                    if (!updateFilter->Matches(ref)) {
-                        skippedCount++;
-                        return RE::BSContainer::ForEachResult::kContinue;
-                    }
-                }
-               
-                processedCount++;
-
-                RuleContext ctx{
-                    eventType,
-                    source, 
-                    ref,
-                    nullptr,
-                    nullptr,
-                    "",
-                    "",
-                    "",
-                    false,
-                    weather
-                };
-                
-                RuleManager::GetSingleton()->Trigger(ctx);
-            } else {
-                if (foundObjects) foundObjects->push_back(ref);
-            }
+            batch.push_back(RuleContext{
+                eventType,
+                source, 
+                ref,
+                nullptr,
+                nullptr,
+                WeaponType::Other,
+                AttackType::Regular,
+                DeliveryType::None,
+                false,
+                weather
+            });
+
+            return RE::BSContainer::ForEachResult::kContinue;
+        });
+    }
+
+    void ScanCell(RE::Actor* source, std::vector<RE::TESObjectREFR*>* foundObjects = nullptr, bool triggerEvents = false, 
+				  EventType eventType = EventType::kNone, RE::TESWeather* weather = nullptr)
+    {
+		if (!EventSinkBase::IsActorSafe(source)) return;
+
+        if (triggerEvents) {
+            // Contexts are collected during the scan and triggered as one batch afterwards
+            static thread_local std::vector<RuleContext> batchBuffer;
+            std::vector<RuleContext> batch;
+            batch.swap(batchBuffer);
+            batch.clear();
+
+            CollectCellContexts(source, eventType, weather, batch);
+            if (!batch.empty()) RuleManager::GetSingleton()->TriggerBatch(batch);
+
+            batch.clear();
+            batch.swap(batchBuffer);
+            return;
+        }
+
+        auto* cell = source->GetParentCell();
+        if (!cell || !foundObjects) return;
 
+        cell->ForEachReference([&](RE::TESObjectREFR* ref) -> RE::BSContainer::ForEachResult {
+            if (EventSinkBase::IsItemSafe(ref)) foundObjects->push_back(ref);
             return RE::BSContainer::ForEachResult::kContinue;
         });
     }
 
+	// Impact hooks only record the hit, the objects around the impact are collected when the queue is drained
 	void HandleProjectileImpact(RE::Projectile* a_proj, const RE::NiPoint3& a_hitPos) 
 	{
+		if (!RuleManager::GetSingleton()->HasRulesFor(EventType::kHit)) return;
 		if (!a_proj || a_proj->IsDeleted()) return;
 
 		try {
@@ -271,12 +204,6 @@ namespace OIF
 		}
 
 		auto& projData = a_proj->GetProjectileRuntimeData();
-
-		RE::TESForm* attackSource = a_proj;
-		RE::TESForm* projectileSource = a_proj;
-		WeaponType weaponType = WeaponType::Ranged;
-		AttackType attackType = AttackType::Regular;
-		DeliveryType deliveryType = DeliveryType::None;
 		RE::TESObjectCELL* cell = a_proj->GetParentCell();
 
 		RE::Actor* actor = RE::PlayerCharacter::GetSingleton();
@@ -296,109 +223,27 @@ namespace OIF
 			}
 			if (!cell) return;
 		}
-		
-		if (auto* projSpell = projData.spell) {
-			if (auto* spell = projSpell->As<RE::SpellItem>()) {
-				attackSource = spell;
-				weaponType = GetSpellType(spell);
-
-				switch (spell->data.castingType) {
-				case RE::MagicSystem::CastingType::kConcentration:
-					attackType = AttackType::Continuous;
-					break;
-				case RE::MagicSystem::CastingType::kFireAndForget:
-					attackType = AttackType::FireAndForget;
-					break;
-				case RE::MagicSystem::CastingType::kConstantEffect:
-					attackType = AttackType::Constant;
-					break;
-				case RE::MagicSystem::CastingType::kScroll:
-					weaponType = WeaponType::Scroll;
-					break;
-				default:
-					break;
-				}
 
-				switch (spell->data.delivery) {
-				case RE::MagicSystem::Delivery::kSelf:
-					deliveryType = DeliveryType::Self;
-					break;
-				case RE::MagicSystem::Delivery::kAimed:
-					deliveryType = DeliveryType::Aimed;
-					break;
-				case RE::MagicSystem::Delivery::kTargetActor:
-					deliveryType = DeliveryType::TargetActor;
-					break;
-				case RE::MagicSystem::Delivery::kTargetLocation:
-					deliveryType = DeliveryType::TargetLocation;
-					break;
-				case RE::MagicSystem::Delivery::kTouch:
-					deliveryType = DeliveryType::Touch;
-					break;
-				case RE::MagicSystem::Delivery::kTotal:
-					deliveryType = DeliveryType::Total;
-					break;
-				default:
-					deliveryType = DeliveryType::None;
-					break;
-				}
-			}
+		RE::TESForm* attackSource = nullptr;
+		if (auto* projSpell = projData.spell) {
+			attackSource = projSpell->As<RE::SpellItem>();
 		} else if (auto* projWeapon = projData.weaponSource) {
 			attackSource = projWeapon;
-			weaponType = GetWeaponType(projWeapon);
-
-			if (auto* actorState = actor->GetActorRuntimeData().currentProcess) {
-				if (auto& highData = actorState->high) {
-					if (auto& attackData = highData->attackData) {
-						attackType = GetAttackType(attackData.get());
-					}
-				}
-			}
 		} else if (auto* projExplosion = projData.explosion) {
 			attackSource = projExplosion;
-			weaponType = WeaponType::Explosion;
 		}
 
-		std::vector<RE::TESObjectREFR*> validObjects;
-
-		cell->ForEachReferenceInRange(a_hitPos, 65.0, [&](RE::TESObjectREFR* ref) {
-			if (!EventSinkBase::IsItemSafe(ref)) return RE::BSContainer::ForEachResult::kContinue;
-			auto* baseObj = ref->GetBaseObject();
-			if (!baseObj) return RE::BSContainer::ForEachResult::kContinue;
-
-			switch (baseObj->GetFormType()) {
-			case RE::FormType::Activator:  // For some activators with bad collision (e.g., some levers can't be hit by arrows)
-			case RE::FormType::Flora:
-			case RE::FormType::Tree:
-				break;
-			default:
-				return RE::BSContainer::ForEachResult::kContinue;
-			}
-
-			validObjects.emplace_back(ref);
-			return RE::BSContainer::ForEachResult::kContinue;
-		});
-
-		if (validObjects.empty()) return;
-
-		SKSE::GetTaskInterface()->AddTask([validObjects, actor, attackSource, projectileSource, weaponType, attackType, deliveryType]() {
-			for (auto& ref : validObjects) {
-				if (EventSinkBase::IsItemSafe(ref)) {
-					RuleContext ctx{
-						EventType::kHit,
-						actor,
-						ref,
-						attackSource,
-						projectileSource,
-						WeaponTypeToString(weaponType),
-						AttackTypeToString(attackType),
-						DeliveryTypeToString(deliveryType),
-						true
-					};
-					RuleManager::GetSingleton()->Trigger(ctx);
-				}
-			}
-		});
+		auto* projectileBase = a_proj->GetBaseObject();
+
+		EventRecord record;
+		record.origin = EventOrigin::kProjectileImpact;
+		record.source = actor->GetFormID();
+		record.target = projectileBase ? projectileBase->GetFormID() : 0;
+		record.form = attackSource ? attackSource->GetFormID() : 0;
+		record.extra = cell->GetFormID();
+		record.position = { a_hitPos.x, a_hitPos.y, a_hitPos.z };
+		record.radius = 65.0f;
+		EventQueue::GetSingleton()->Push(record);
 	}
 
 
@@ -411,6 +256,7 @@ namespace OIF
     
 	RE::BSEventNotifyControl ActivateSink::ProcessEvent(const RE::TESActivateEvent* evn, RE::BSTEventSource<RE::TESActivateEvent>*)
     {
+        if (!RuleManager::GetSingleton()->HasRulesFor(EventType::kActivate)) return RE::BSEventNotifyControl::kContinue;
         if (!evn || !evn->objectActivated) return RE::BSEventNotifyControl::kContinue;
 
         auto targetRef = evn->objectActivated;
@@ -426,23 +272,18 @@ namespace OIF
         RE::FormID sourceID = source->GetFormID();
         RE::FormID targetID = targetRef->GetFormID();
 
-        SKSE::GetTaskInterface()->AddTask([sourceID, targetID]() {
-            auto* source = RE::TESForm::LookupByID<RE::Actor>(sourceID);
-            auto* targetRef = RE::TESForm::LookupByID<RE::TESObjectREFR>(targetID);
-            
-            RuleContext ctx{ 
-                EventType::kActivate, 
-                source, 
-                targetRef
-            };
-            RuleManager::GetSingleton()->Trigger(ctx);
-        });
+        EventRecord record;
+        record.origin = EventOrigin::kActivate;
+        record.source = sourceID;
+        record.target = targetID;
+        EventQueue::GetSingleton()->Push(record);
 
         return RE::BSEventNotifyControl::kContinue;
     }
 
     RE::BSEventNotifyControl HitSink::ProcessEvent(const RE::TESHitEvent* evn, RE::BSTEventSource<RE::TESHitEvent>*)
     {
+        if (!RuleManager::GetSingleton()->HasRulesFor(EventType::kHit)) return RE::BSEventNotifyControl::kContinue;
         if (!evn || !evn->target) return RE::BSEventNotifyControl::kContinue;
 
         auto targetRef = evn->target;
@@ -460,119 +301,20 @@ namespace OIF
         RE::FormID sourceID = source->GetFormID();
         RE::FormID targetID = targetRef->GetFormID();
 
-        SKSE::GetTaskInterface()->AddTask([hitSourceID, projectileID, sourceID, targetID]() {
-            auto* source = RE::TESForm::LookupByID<RE::Actor>(sourceID);
-            auto* targetRef = RE::TESForm::LookupByID<RE::TESObjectREFR>(targetID);
-            auto* hitSourceForm = hitSourceID ? RE::TESForm::LookupByID(hitSourceID) : nullptr;
-            auto* projectileForm = projectileID ? RE::TESForm::LookupByID<RE::BGSProjectile>(projectileID) : nullptr;
-
-            if (!EventSinkBase::IsActorSafe(source) || !EventSinkBase::IsItemSafe(targetRef)) return;
-
-            RE::TESForm* attackSource = nullptr;
-            RE::TESForm* projectileSource = nullptr;
-            WeaponType weaponType = WeaponType::Other;
-            AttackType attackType = AttackType::Regular;
-            DeliveryType deliveryType = DeliveryType::None;
-
-            if (hitSourceForm && hitSourceForm->As<RE::BGSExplosion>()) return;
-
-            if (auto* actorState = source->GetActorRuntimeData().currentProcess) {
-                auto* highData = actorState->high;
-                if (!highData) return;
-
-                if (highData->attackData) attackType = GetAttackType(highData->attackData.get());
-
-                if (highData->muzzleFlash && highData->muzzleFlash->baseProjectile) {
-                    auto* projectile = highData->muzzleFlash->baseProjectile;
-                    if (projectile->As<RE::BGSExplosion>()) return;
-					weaponType = WeaponType::Ranged;
-                    attackSource = projectile;
-                    projectileSource = projectile;
-                }
-            }
-
-			if (projectileForm) {
-				if (projectileForm->As<RE::BGSExplosion>()) return;
-				weaponType = WeaponType::Ranged;
-				attackSource = projectileForm;
-				projectileSource = projectileForm;
-			}
-
-            if (hitSourceForm) {
-                if (auto* spell = hitSourceForm->As<RE::SpellItem>()) {
-                    weaponType = GetSpellType(spell);
-                    attackSource = spell;
-                    
-                    if (spell->effects.size() > 0) {
-                        auto* effect = spell->effects[0];
-                        if (effect && effect->baseEffect) {
-                            switch (effect->baseEffect->data.delivery) {
-                                case RE::MagicSystem::Delivery::kSelf:
-                                    deliveryType = DeliveryType::Self;
-                                    break;
-                                case RE::MagicSystem::Delivery::kAimed:
-                                    deliveryType = DeliveryType::Aimed;
-                                    break;
-                                case RE::MagicSystem::Delivery::kTargetActor:
-                                    deliveryType = DeliveryType::TargetActor;
-                                    break;
-                                case RE::MagicSystem::Delivery::kTargetLocation:
-                                    deliveryType = DeliveryType::TargetLocation;
-                                    break;
-                                case RE::MagicSystem::Delivery::kTouch:
-                                    deliveryType = DeliveryType::Touch;
-                                    break;
-                                default:
-                                    deliveryType = DeliveryType::None;
-                                    break;
-                            }
-                        }
-                    }
-
-                    switch (spell->GetCastingType()) {
-                        case RE::MagicSystem::CastingType::kConcentration:
-                            attackType = AttackType::Continuous;
-                            break;
-                        case RE::MagicSystem::CastingType::kFireAndForget:
-                            attackType = AttackType::FireAndForget;
-                            break;
-                        case RE::MagicSystem::CastingType::kConstantEffect:
-                            attackType = AttackType::Constant;
-                            break;
-                        case RE::MagicSystem::CastingType::kScroll:
-                            weaponType = WeaponType::Scroll;
-                            break;
-                        default:
-                            break;
-                    }
-                }
-
-                else if (auto* weapon = hitSourceForm->As<RE::TESObjectWEAP>()) {
-                    weaponType = GetWeaponType(weapon);
-                    attackSource = weapon;
-                }
-            }
-
-            RuleContext ctx{ 
-                EventType::kHit,
-                source,
-                targetRef, 
-                attackSource,
-                projectileSource,
-                WeaponTypeToString(weaponType),
-                AttackTypeToString(attackType),
-                DeliveryTypeToString(deliveryType),
-                true
-            };
-            
-            RuleManager::GetSingleton()->Trigger(ctx);
-        });
+        EventRecord record;
+        record.origin = EventOrigin::kHit;
+        record.source = sourceID;
+        record.target = targetID;
+        record.form = hitSourceID;
+        record.extra = projectileID;
+        EventQueue::GetSingleton()->Push(record);
 
         return RE::BSEventNotifyControl::kContinue;
     }
 
     RE::BSEventNotifyControl MagicEffectApplySink::ProcessEvent(const RE::TESMagicEffectApplyEvent* evn, RE::BSTEventSource<RE::TESMagicEffectApplyEvent>*)
     {
+        if (!RuleManager::GetSingleton()->HasRulesFor(EventType::kHit)) return RE::BSEventNotifyControl::kContinue;
         if (!evn || !evn->target) return RE::BSEventNotifyControl::kContinue;
     
         auto targetRef = evn->target;
@@ -602,145 +344,12 @@ namespace OIF
         if (casterID == 0) return RE::BSEventNotifyControl::kContinue;
         if (magicEffectID == 0) return RE::BSEventNotifyControl::kContinue;
     
-        SKSE::GetTaskInterface()->AddTask([targetID, magicEffectID, casterID]() {
-            auto* targetRef = RE::TESForm::LookupByID<RE::TESObjectREFR>(targetID);
-            auto* magicEffect = RE::TESForm::LookupByID<RE::EffectSetting>(magicEffectID);
-            auto* caster = RE::TESForm::LookupByID<RE::Actor>(casterID);
-            
-            if (!EventSinkBase::IsItemSafe(targetRef)) return;
-            if (!magicEffect) return;
-			if (!EventSinkBase::IsActorSafe(caster)) return;
-    
-            RE::TESForm* attackSource = magicEffect;
-            RE::TESForm* projectileSource = nullptr;
-            WeaponType weaponType = WeaponType::Other;
-            AttackType attackType = AttackType::Regular;
-            DeliveryType deliveryType = DeliveryType::None;
-            bool isShout = false;
-            bool isSpell = false;
-
-            if (magicEffect->data.projectileBase) {
-                if (!magicEffect->data.projectileBase->As<RE::BGSExplosion>()) {
-					weaponType = WeaponType::Ranged;
-                    attackSource = magicEffect->data.projectileBase;
-                    projectileSource = magicEffect->data.projectileBase;
-                }
-            }
-    
-            if (magicEffect->data.associatedForm && magicEffect->data.associatedForm->formType == RE::FormType::Shout) {
-                weaponType = WeaponType::Shout;
-                attackSource = magicEffect->data.associatedForm;
-                isShout = true;
-            }
-            
-            if (!isShout) {
-                auto* currentShout = caster->GetCurrentShout();
-                if (currentShout) {
-                    for (int i = 0; i < RE::TESShout::VariationIDs::kTotal; ++i) {
-                        auto& variation = currentShout->variations[i];
-                        if (variation.spell) {
-                            for (auto* effect : variation.spell->effects) {
-                                if (effect && effect->baseEffect == magicEffect) {
-                                    weaponType = WeaponType::Shout;
-                                    attackSource = currentShout;
-                                    isShout = true;
-                                    break;
-                                }
-                            }
-                            if (isShout) break;
-                        }
-                    }
-                }
-            }
-    
-            if (!isShout) {
-                RE::SpellItem* sourceSpell = nullptr;
-    
-                std::array<RE::MagicSystem::CastingSource, 4> castingSources = {
-                    RE::MagicSystem::CastingSource::kInstant,
-                    RE::MagicSystem::CastingSource::kLeftHand,
-                    RE::MagicSystem::CastingSource::kOther,
-                    RE::MagicSystem::CastingSource::kRightHand
-                };
-    
-                for (auto castingSource : castingSources) {
-                    if (auto* casterActor = caster->As<RE::Actor>()) {
-                        if (auto* magicCaster = casterActor->GetMagicCaster(castingSource)) {
-                            if (auto* currentSpell = magicCaster->currentSpell) {
-                                for (auto* effect : currentSpell->effects) {
-                                    if (effect && effect->baseEffect == magicEffect) {
-                                        sourceSpell = currentSpell->As<RE::SpellItem>();
-                                        break;
-                                    }
-                                }
-                                if (sourceSpell) break;
-                            }
-                        }
-                    }
-                }
-    
-                if (sourceSpell) {
-                    weaponType = GetSpellType(sourceSpell);
-                    attackSource = sourceSpell;
-                    isSpell = true;
-                }
-            }
-
-            switch (magicEffect->data.castingType) {
-                case RE::MagicSystem::CastingType::kConcentration:
-                    attackType = AttackType::Continuous;
-                    break;
-                case RE::MagicSystem::CastingType::kFireAndForget:
-                    attackType = AttackType::FireAndForget;
-                    break;
-                case RE::MagicSystem::CastingType::kConstantEffect:
-                    attackType = AttackType::Constant;
-                    break;
-                case RE::MagicSystem::CastingType::kScroll:
-                    weaponType = WeaponType::Scroll;
-                    break;
-                default:
-                    break;
-            }
-    
-            switch (magicEffect->data.delivery) {
-                case RE::MagicSystem::Delivery::kSelf:
-                    deliveryType = DeliveryType::Self;
-                    break;
-                case RE::MagicSystem::Delivery::kAimed:
-                    deliveryType = DeliveryType::Aimed;
-                    break;
-                case RE::MagicSystem::Delivery::kTargetActor:
-                    deliveryType = DeliveryType::TargetActor;
-                    break;
-                case RE::MagicSystem::Delivery::kTargetLocation:
-                    deliveryType = DeliveryType::TargetLocation;
-                    break;
-                case RE::MagicSystem::Delivery::kTouch:
-                    deliveryType = DeliveryType::Touch;
-                    break;
-                case RE::MagicSystem::Delivery::kTotal:
-                    deliveryType = DeliveryType::Total;
-                    break;
-                default:
-                    deliveryType = DeliveryType::None;
-                    break;
-            }
-
-            RuleContext ctx{
-                EventType::kHit,
-                caster,
-                targetRef,
-                attackSource,
-                projectileSource,
-                WeaponTypeToString(weaponType),
-                AttackTypeToString(attackType),
-                DeliveryTypeToString(deliveryType),
-                true
-            };
-        
-            RuleManager::GetSingleton()->Trigger(ctx);
-        });
+        EventRecord record;
+        record.origin = EventOrigin::kMagicEffectApply;
+        record.source = casterID;
+        record.target = targetID;
+        record.form = magicEffectID;
+        EventQueue::GetSingleton()->Push(record);
     
         return RE::BSEventNotifyControl::kContinue;
     }
@@ -748,6 +357,7 @@ namespace OIF
     RE::BSEventNotifyControl GrabReleaseSink::ProcessEvent(const RE::TESGrabReleaseEvent* evn, RE::BSTEventSource<RE::TESGrabReleaseEvent>*)
     {
         if (!evn || !evn->ref) return RE::BSEventNotifyControl::kContinue;
+        if (!RuleManager::GetSingleton()->HasRulesFor(evn->grabbed ? EventBit(EventType::kGrab) : kReleaseEvents)) return RE::BSEventNotifyControl::kContinue;
 
         auto targetRef = evn->ref;
 		if (!EventSinkBase::IsItemSafe(targetRef.get())) return RE::BSEventNotifyControl::kContinue;
@@ -757,85 +367,11 @@ namespace OIF
 
         if (!EventSinkBase::IsActorSafe(source)) return RE::BSEventNotifyControl::kContinue;
 
-        bool isGrabbed = evn->grabbed;
-
-        if (isGrabbed) {
-            SKSE::GetTaskInterface()->AddTask([source, targetRef]() {
-                RuleContext ctx{
-                    EventType::kGrab,
-                    source,
-					targetRef.get(),
-					targetRef->GetBaseObject()
-                };
-                RuleManager::GetSingleton()->Trigger(ctx);
-            });
-        } else {
-            SKSE::GetTaskInterface()->AddTask([source, targetRef]() {
-				bool isTelekinesis = false;
-                bool isThrown = false;
-
-                RE::TESForm* leftSpell = source->GetEquippedObject(true);
-                RE::TESForm* rightSpell = source->GetEquippedObject(false);
-                    
-                RE::MagicItem* leftMagicItem = leftSpell ? leftSpell->As<RE::MagicItem>() : nullptr;
-                RE::MagicItem* rightMagicItem = rightSpell ? rightSpell->As<RE::MagicItem>() : nullptr;
-                    
-                if ((leftSpell || rightSpell) && (leftMagicItem || rightMagicItem)) {
-                    bool hasGrabEffect = false;
-                    for (auto* spell : { leftMagicItem, rightMagicItem }) {
-                        if (spell) {
-                            for (auto* effect : spell->effects) {
-                                if (effect && effect->baseEffect) {
-                                    if (effect->baseEffect->data.archetype == RE::EffectArchetypes::ArchetypeID::kTelekinesis ||
-                                        effect->baseEffect->data.archetype == RE::EffectArchetypes::ArchetypeID::kGrabActor) {
-                                        hasGrabEffect = true;
-                                        break;
-                                    }
-                                }
-                            }
-                        }
-                        if (hasGrabEffect) break;
-                    }
-                    isTelekinesis = hasGrabEffect;
-                }
-
-                auto* inputHandler = InputHandler::GetSingleton();
-                bool wasRKeyReleased = inputHandler->WasKeyJustReleased();
-                    
-                if (auto threedimObj = targetRef->Get3D()) {
-                    if (auto collisionObj = threedimObj->GetCollisionObject()) {
-                        if (auto bhkBody = collisionObj->GetRigidBody()) {
-                            if (auto hkpBody = bhkBody->GetRigidBody()) {
-                                if (isTelekinesis || (!isTelekinesis && wasRKeyReleased)) {
-                                    int propertyId = isTelekinesis ? 314159 : 628318; // HK_PROPERTY_TELEKINESIS : HK_PROPERTY_GRABTHROWNOBJECT
-                                        
-                                    if (hkpBody->HasProperty(propertyId)) {
-                                        float now = duration_cast<duration<float>>(steady_clock::now() - startTime).count();
-                                        hkpBody->SetProperty(propertyId, now);
-                                    }
-                                        
-                                    hkpBody->AddContactListener(LandingSink::GetSingleton());
-                                }
-                                    
-                                if (wasRKeyReleased) {
-                                    isThrown = true;
-                                    InputHandler::GetSingleton()->ResetKeyState();
-                                }
-                            }
-                        }
-                    }
-                }
-                if (!isThrown) {
-                    RuleContext ctx{
-                        EventType::kRelease,
-                        source,
-						targetRef.get(),
-						targetRef->GetBaseObject()
-                    };
-                    RuleManager::GetSingleton()->Trigger(ctx);
-                }
-            });
-        }
+        EventRecord record;
+        record.origin = evn->grabbed ? EventOrigin::kGrab : EventOrigin::kRelease;
+        record.source = source->GetFormID();
+        record.target = targetRef->GetFormID();
+        EventQueue::GetSingleton()->Push(record);
 
         return RE::BSEventNotifyControl::kContinue;
     }
@@ -843,6 +379,7 @@ namespace OIF
     void LandingSink::ContactPointCallback(const RE::hkpContactPointEvent& a_event) 
     {
         if (!a_event.contactPoint || !a_event.firstCallbackForFullManifold) return;
+        if (!RuleManager::GetSingleton()->HasRulesFor(kLandingEvents)) return;
 
         auto bodyA = a_event.bodies[0];
         auto bodyB = a_event.bodies[1];
@@ -883,51 +420,70 @@ namespace OIF
             std::uint32_t objectID = refr->GetFormID();
             if (!objectID) return;
 
-            if (processedObjects.find(objectID) != processedObjects.end()) return;
+            const std::uint32_t slot = TryClaim(objectID);
+            if (slot == kNoSlot) return;
+
+            PendingLanding landing{ objectID, slot };
+            if (isTelekinesis) {
+                landing.event = EventType::kTelekinesis;
+            } else if (isThrown) {
+                landing.event = EventType::kThrow;
+            } else if (isDropped) {
+                landing.event = EventType::kDrop;
+            }
 
-            processedObjects.insert(objectID);
-            bodiesToCleanup.push_back(specialBody);
+            // With the ring full the object is released again, its next contact retries
+            if (!pendingLandings.TryPush(landing)) {
+                landedObjects[slot].store(0, std::memory_order_release);
+            }
+        }
+    }
 
-			SKSE::GetTaskInterface()->AddTask([refr, objectID, isTelekinesis, isThrown, isDropped, this]() {
-				EventType eventType = EventType::kNone;
-				if (isTelekinesis) {
-					eventType = EventType::kTelekinesis;
-				} else if (isThrown) {
-					eventType = EventType::kThrow;
-				} else if (isDropped) {
-					eventType = EventType::kDrop;
-				}
+    std::uint32_t LandingSink::TryClaim(RE::FormID objectID)
+    {
+        const std::size_t start = static_cast<std::size_t>((objectID * 2654435761u) >> 16);
 
-				RuleContext ctx{
-					eventType,
-					RE::PlayerCharacter::GetSingleton()->As<RE::Actor>(),
-					refr,
-					refr->GetBaseObject()
-				};
-				RuleManager::GetSingleton()->Trigger(ctx);
+        for (std::size_t i = 0; i < kLandedProbe; ++i) {
+            if (landedObjects[(start + i) & (kLandedCapacity - 1)].load(std::memory_order_acquire) == objectID) return kNoSlot;
+        }
 
-				SKSE::GetTaskInterface()->AddTask([this, objectID]() {
-					processedObjects.erase(objectID);
-				});
-			});
+        for (std::size_t i = 0; i < kLandedProbe; ++i) {
+            const std::size_t idx = (start + i) & (kLandedCapacity - 1);
+            RE::FormID expected = 0;
+            if (landedObjects[idx].compare_exchange_strong(expected, objectID, std::memory_order_acq_rel)) return static_cast<std::uint32_t>(idx);
+            if (expected == objectID) return kNoSlot;                                       // another physics thread got there first
+        }
 
-            SKSE::GetTaskInterface()->AddTask([this]() {
-                for (auto* body : bodiesToCleanup) {
-                    if (body) {
-                        if (body->HasProperty(HK_PROPERTY_TELEKINESIS)) {
-                            body->RemoveProperty(HK_PROPERTY_TELEKINESIS);
-                        }
-                        if (body->HasProperty(HK_PROPERTY_GRABTHROWNOBJECT)) {
-                            body->RemoveProperty(HK_PROPERTY_GRABTHROWNOBJECT);
-                        }
-						if (body->HasProperty(HK_PROPERTY_DROPPEDOBJECT)) {
-							body->RemoveProperty(HK_PROPERTY_DROPPEDOBJECT);
-						}
-                        body->RemoveContactListener(this);
+        return kNoSlot;
+    }
+
+    void LandingSink::ProcessLandings()
+    {
+        PendingLanding landing;
+        while (pendingLandings.TryPop(landing)) {
+            if (auto* refr = RE::TESForm::LookupByID<RE::TESObjectREFR>(landing.objectID)) {
+                if (auto* body = GetRigidBody(refr)) {
+                    if (body->HasProperty(HK_PROPERTY_TELEKINESIS)) {
+                        body->RemoveProperty(HK_PROPERTY_TELEKINESIS);
                     }
+                    if (body->HasProperty(HK_PROPERTY_GRABTHROWNOBJECT)) {
+                        body->RemoveProperty(HK_PROPERTY_GRABTHROWNOBJECT);
+                    }
+                    if (body->HasProperty(HK_PROPERTY_DROPPEDOBJECT)) {
+                        body->RemoveProperty(HK_PROPERTY_DROPPEDOBJECT);
+                    }
+                    body->RemoveContactListener(this);
                 }
-                bodiesToCleanup.clear();
-            });
+            }
+
+            // The listener is gone, so the object can only land again after a new grab or drop
+            landedObjects[landing.slot].store(0, std::memory_order_release);
+
+            EventRecord record;
+            record.origin = EventOrigin::kLanding;
+            record.target = landing.objectID;
+            record.event = landing.event;
+            EventQueue::GetSingleton()->Push(record);
         }
     }
 
@@ -938,56 +494,40 @@ namespace OIF
 		auto targetRef = evn->reference;
 		bool attached = evn->attached;
 
+		auto* ruleManager = RuleManager::GetSingleton();
+
+		// Cached OnUpdate results are only valid while the reference stays loaded
+		if (!attached && ruleManager->HasRulesFor(EventType::kOnUpdate)) ruleManager->ForgetStaticMatches(targetRef->GetFormID());
+
+		const EventType eventType = attached ? EventType::kCellAttach : EventType::kCellDetach;
+		if (!ruleManager->HasRulesFor(eventType)) return RE::BSEventNotifyControl::kContinue;
 		if (!EventSinkBase::IsItemSafe(targetRef.get())) return RE::BSEventNotifyControl::kContinue;
 
-		SKSE::GetTaskInterface()->AddTask([targetRef, attached]() {
-			if (attached) {
-				RuleContext ctx{
-					EventType::kCellAttach,
-					RE::PlayerCharacter::GetSingleton()->As<RE::Actor>(),
-					targetRef.get(),
-					targetRef->GetBaseObject()
-				};
-				RuleManager::GetSingleton()->Trigger(ctx);
-			} else {
-				RuleContext ctx{
-					EventType::kCellDetach,
-					RE::PlayerCharacter::GetSingleton()->As<RE::Actor>(),
-					targetRef.get(),
-					targetRef->GetBaseObject()
-				};
-				RuleManager::GetSingleton()->Trigger(ctx);
-			}
-		});
+		// References none of the event's rules can match are dropped before they are queued
+		auto ruleSet = ruleManager->GetRuleSet();
+		if (!ruleSet || !ruleSet->prefilters[static_cast<std::size_t>(eventType)].Matches(targetRef.get())) return RE::BSEventNotifyControl::kContinue;
+
+		EventRecord record;
+		record.origin = attached ? EventOrigin::kCellAttach : EventOrigin::kCellDetach;
+		record.target = targetRef->GetFormID();
+		EventQueue::GetSingleton()->Push(record);
 
 		return RE::BSEventNotifyControl::kContinue;
 	}
 
 	RE::BSEventNotifyControl DestructionStageChangedSink::ProcessEvent(const RE::TESDestructionStageChangedEvent* evn, RE::BSTEventSource<RE::TESDestructionStageChangedEvent>*)
 	{
+		if (!RuleManager::GetSingleton()->HasRulesFor(EventType::kDestructionStageChange)) return RE::BSEventNotifyControl::kContinue;
 		if (!evn || !evn->target) return RE::BSEventNotifyControl::kContinue;
 
 		auto targetRef = evn->target;
 		if (!EventSinkBase::IsItemSafe(targetRef.get())) return RE::BSEventNotifyControl::kContinue;
 
-		std::int32_t stage = evn->newStage;
-
-		SKSE::GetTaskInterface()->AddTask([targetRef, stage]() {
-			RuleContext ctx{
-				EventType::kDestructionStageChange,
-				RE::PlayerCharacter::GetSingleton()->As<RE::Actor>(),
-				targetRef.get(),
-				nullptr,
-				nullptr,
-				"",
-				"",
-				"",
-				true,
-				nullptr,
-				stage
-			};
-			RuleManager::GetSingleton()->Trigger(ctx);
-		});
+		EventRecord record;
+		record.origin = EventOrigin::kDestructionStage;
+		record.target = targetRef->GetFormID();
+		record.stage = evn->newStage;
+		EventQueue::GetSingleton()->Push(record);
 
 		return RE::BSEventNotifyControl::kContinue;
 	}
@@ -1102,6 +642,7 @@ namespace OIF
 	void ExplosionHook::thunk(RE::Explosion* a_this)
 	{
 		func(a_this);
+		if (!RuleManager::GetSingleton()->HasRulesFor(EventType::kHit)) return;
 		if (!a_this || a_this->IsDeleted()) return;
 
 		auto& runtimeData = a_this->GetExplosionRuntimeData();
@@ -1145,45 +686,14 @@ namespace OIF
 		RE::FormID attackSourceFormID = attackSource ? attackSource->GetFormID() : 0;
 		RE::FormID cellFormID = cell ? cell->GetFormID() : 0;
 
-		SKSE::GetTaskInterface()->AddTask([actorFormID, attackSourceFormID, cellFormID, explosionPos, explosionRadius]() 
-		{
-			RE::Actor* actor = nullptr;
-			if (actorFormID != 0) actor = RE::TESForm::LookupByID<RE::Actor>(actorFormID);
-			if (!EventSinkBase::IsActorSafe(actor)) return;
-
-			RE::TESForm* attackSource = nullptr;
-			if (attackSourceFormID != 0) attackSource = RE::TESForm::LookupByID(attackSourceFormID);
-
-			RE::TESObjectCELL* cell = nullptr;
-			if (cellFormID != 0) {
-				cell = RE::TESForm::LookupByID<RE::TESObjectCELL>(cellFormID);
-			} else {
-				if (actor) cell = actor->GetParentCell();
-				if (!cell) {
-					if (auto* player = RE::PlayerCharacter::GetSingleton()) cell = player->GetParentCell();
-				}
-				if (!cell) return;
-			}
-
-			cell->ForEachReferenceInRange(explosionPos, explosionRadius, [&](RE::TESObjectREFR* ref) -> RE::BSContainer::ForEachResult 
-			{
-				RuleContext ctx{
-					EventType::kHit,
-					actor,
-					ref,
-					attackSource,
-					nullptr,
-					WeaponTypeToString(WeaponType::Explosion),
-					AttackTypeToString(AttackType::Regular),
-					DeliveryTypeToString(DeliveryType::None),
-					true
-				};
-
-				RuleManager::GetSingleton()->Trigger(ctx);
-
-				return RE::BSContainer::ForEachResult::kContinue;
-			});
-		});
+		EventRecord record;
+		record.origin = EventOrigin::kExplosion;
+		record.source = actorFormID;
+		record.form = attackSourceFormID;
+		record.extra = cellFormID;
+		record.position = { explosionPos.x, explosionPos.y, explosionPos.z };
+		record.radius = explosionRadius;
+		EventQueue::GetSingleton()->Push(record);
 	}
 
     void ReadyWeaponHook::thunk(RE::ReadyWeaponHandler* a_this, RE::ButtonEvent* a_event, RE::PlayerControlsData* a_data)
@@ -1205,18 +715,36 @@ namespace OIF
         if (a_currentWeather == currentWeather) return;
         
         currentWeather = a_currentWeather;
-        
-        SKSE::GetTaskInterface()->AddTask([a_currentWeather]() {
-            auto* player = RE::PlayerCharacter::GetSingleton();
-            if (!player) return;
+        if (!RuleManager::GetSingleton()->HasRulesFor(EventType::kWeatherChange)) return;
 
-            ScanCell(player, nullptr, true, EventType::kWeatherChange, a_currentWeather);
-        });
+        EventRecord record;
+        record.origin = EventOrigin::kWeatherChange;
+        record.form = a_currentWeather->GetFormID();
+        EventQueue::GetSingleton()->Push(record);
     }
 
     void UpdateHook::thunk(RE::PlayerCharacter* a_this, float a_delta)
     {
 		func(a_this, a_delta);
+
+        // Filter checks share one world state capture per frame, counter maintenance runs in small steps
+        RuleManager::GetSingleton()->AdvanceFrame();
+        RuleManager::GetSingleton()->CleanupCounters();
+
+        // Game-time timers only advance while the player updates, so menus and loading screens pause them
+        Scheduler::GetSingleton()->AdvanceGameTime(a_delta, std::max<std::uint32_t>(Settings::GetSingleton()->gameTimerTasksPerFrame, 1));
+
+        // Queues fall back to draining from SKSE tasks once the player update stops marking frames
+        FrameDriver::MarkFrame();
+
+        // Landings reported by the physics thread join the other events queued since the previous frame,
+        // all of them are evaluated together and their effects run in the same frame
+        LandingSink::GetSingleton()->ProcessLandings();
+        EventQueue::GetSingleton()->RunFrame();
+
+        // Queued effects run under a time budget, whatever is left waits for the next frame
+        EffectQueue::GetSingleton()->RunFrame(Settings::GetSingleton()->effectBudgetMs);
+
         if (!EventSinkBase::IsActorSafe(a_this)) return;
 
         static auto lastUpdateTime = std::chrono::steady_clock::now();
@@ -1229,24 +757,19 @@ namespace OIF
         auto* ruleManager = RuleManager::GetSingleton();
         if (!ruleManager) return;
 
-        bool hasAnyUpdateRules = false;
-    
-        {
-            std::shared_lock lock(ruleManager->_ruleMutex);
-            const auto& updateRules = ruleManager->GetUpdateRules();
-            if (updateRules.empty()) return;
-            hasAnyUpdateRules = !updateRules.empty();
-        }
-    
-        if (hasAnyUpdateRules) {
-            const auto& updateFilter = ruleManager->GetUpdateFilter();
-            ScanCell(a_this, nullptr, true, EventType::kOnUpdate, nullptr, &updateFilter);
-        }
+        ruleManager->UpdatePredicateOrder();
+        EventQueue::GetSingleton()->ReportMetrics();
+        EffectQueue::GetSingleton()->ReportMetrics();
+
+        if (!ruleManager->HasRulesFor(EventType::kOnUpdate)) return;
+
+        ScanCell(a_this, nullptr, true, EventType::kOnUpdate);
     }
 
 	void AttackBlockHook::thunk(RE::AttackBlockHandler* a_this, RE::ButtonEvent* a_event, RE::PlayerControlsData* a_data)
 	{
 		func(a_this, a_event, a_data);
+		if (!RuleManager::GetSingleton()->HasRulesFor(EventType::kHit)) return;
 		
 		if (a_event) {
 			if (!a_event->IsDown()) return;
@@ -1422,12 +945,16 @@ namespace OIF
 
 		if (validObjects.empty()) return;
 
-		static std::vector<std::future<void>> runningTasks;
-		static std::mutex tasksMutex;
+		// Objects are kept by handle, they may unload before the delay ends
+		std::vector<RE::RefHandle> validHandles;
+		validHandles.reserve(validObjects.size());
+		for (auto* ref : validObjects) {
+			validHandles.push_back(ref->CreateRefHandle().native_handle());
+		}
 
 		// Wait for the animation to finish before triggering the rule (approximate duration)
-		auto future = std::async(std::launch::async, [a_event, validObjects, player, attackSource, projectileSource, weaponType, attackType, deliveryType, duration = 0.5]() {
-			std::this_thread::sleep_for(std::chrono::duration<float>(duration));
+		Scheduler::GetSingleton()->Schedule(0.5f, [validHandles = std::move(validHandles), player, attackSource, projectileSource, weaponType, attackType, deliveryType]() {
+			if (!EventSinkBase::IsActorSafe(player)) return;
 
 			if (player->AsActorState()) {
 				if (player->AsActorState()->GetAttackState() != RE::ATTACK_STATE_ENUM::kBowReleasing &&
@@ -1443,37 +970,26 @@ namespace OIF
 					player->AsActorState()->GetAttackState() != RE::ATTACK_STATE_ENUM::kHit) return;
 			}
 
-			SKSE::GetTaskInterface()->AddTask([validObjects, player, attackSource, projectileSource, weaponType, attackType, deliveryType]() {
-				for (auto& ref : validObjects) {
-					if (EventSinkBase::IsItemSafe(ref)) {
-						RuleContext ctx{
-							EventType::kHit,
-							player->As<RE::Actor>(),
-							ref,
-							attackSource,
-							projectileSource,
-							WeaponTypeToString(weaponType),
-							AttackTypeToString(attackType),
-							DeliveryTypeToString(deliveryType),
-							true
-						};
-						RuleManager::GetSingleton()->Trigger(ctx);
-					}
-				}
-			});
-		});
-
-		{
-			std::lock_guard<std::mutex> lock(tasksMutex);
-			runningTasks.push_back(std::move(future));
+			std::vector<RuleContext> batch;
+			batch.reserve(validHandles.size());
+			for (auto handle : validHandles) {
+				RE::NiPointer<RE::TESObjectREFR> ref;
+				if (!RE::TESObjectREFR::LookupByHandle(handle, ref) || !EventSinkBase::IsItemSafe(ref.get())) continue;
 
-			runningTasks.erase(
-				std::remove_if(runningTasks.begin(), runningTasks.end(),
-					[](const std::future<void>& f) {
-						return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
-					}),
-				runningTasks.end());
-		}
+				batch.push_back(RuleContext{
+					EventType::kHit,
+					player->As<RE::Actor>(),
+					ref.get(),
+					attackSource,
+					projectileSource,
+					weaponType,
+					attackType,
+					deliveryType,
+					true
+				});
+			}
+			RuleManager::GetSingleton()->TriggerBatch(batch);
+		});
 	}
 
 	// Sinks cause crashes, need further investigation
@@ -1518,6 +1034,586 @@ namespace OIF
 	//	HandleProjectileImpact(a_proj, a_hitPos);
 	//}
 
+// ╔════════════════════════════════════╗
+// ║          EVENT NORMALIZING         ║
+// ╚════════════════════════════════════╝
+// Queued records are turned back into rule contexts on the main thread, once per frame
+
+    static void NormalizeActivate(const EventRecord& record, std::vector<RuleContext>& batch)
+    {
+        auto* source = RE::TESForm::LookupByID<RE::Actor>(record.source);
+        auto* targetRef = RE::TESForm::LookupByID<RE::TESObjectREFR>(record.target);
+        if (!EventSinkBase::IsActorSafe(source) || !EventSinkBase::IsItemSafe(targetRef)) return;
+
+        batch.push_back(RuleContext{
+            EventType::kActivate,
+            source,
+            targetRef
+        });
+    }
+
+    static void NormalizeHit(const EventRecord& record, std::vector<RuleContext>& batch)
+    {
+        auto* source = RE::TESForm::LookupByID<RE::Actor>(record.source);
+        auto* targetRef = RE::TESForm::LookupByID<RE::TESObjectREFR>(record.target);
+        auto* hitSourceForm = record.form ? RE::TESForm::LookupByID(record.form) : nullptr;
+        auto* projectileForm = record.extra ? RE::TESForm::LookupByID<RE::BGSProjectile>(record.extra) : nullptr;
+
+        if (!EventSinkBase::IsActorSafe(source) || !EventSinkBase::IsItemSafe(targetRef)) return;
+
+        RE::TESForm* attackSource = nullptr;
+        RE::TESForm* projectileSource = nullptr;
+        WeaponType weaponType = WeaponType::Other;
+        AttackType attackType = AttackType::Regular;
+        DeliveryType deliveryType = DeliveryType::None;
+
+        if (hitSourceForm && hitSourceForm->As<RE::BGSExplosion>()) return;
+
+        if (auto* actorState = source->GetActorRuntimeData().currentProcess) {
+            auto* highData = actorState->high;
+            if (!highData) return;
+
+            if (highData->attackData) attackType = GetAttackType(highData->attackData.get());
+
+            if (highData->muzzleFlash && highData->muzzleFlash->baseProjectile) {
+                auto* projectile = highData->muzzleFlash->baseProjectile;
+                if (projectile->As<RE::BGSExplosion>()) return;
+				weaponType = WeaponType::Ranged;
+                attackSource = projectile;
+                projectileSource = projectile;
+            }
+        }
+
+		if (projectileForm) {
+			if (projectileForm->As<RE::BGSExplosion>()) return;
+			weaponType = WeaponType::Ranged;
+			attackSource = projectileForm;
+			projectileSource = projectileForm;
+		}
+
+        if (hitSourceForm) {
+            if (auto* spell = hitSourceForm->As<RE::SpellItem>()) {
+                weaponType = GetSpellType(spell);
+                attackSource = spell;
+                
+                if (spell->effects.size() > 0) {
+                    auto* effect = spell->effects[0];
+                    if (effect && effect->baseEffect) {
+                        switch (effect->baseEffect->data.delivery) {
+                            case RE::MagicSystem::Delivery::kSelf:
+                                deliveryType = DeliveryType::Self;
+                                break;
+                            case RE::MagicSystem::Delivery::kAimed:
+                                deliveryType = DeliveryType::Aimed;
+                                break;
+                            case RE::MagicSystem::Delivery::kTargetActor:
+                                deliveryType = DeliveryType::TargetActor;
+                                break;
+                            case RE::MagicSystem::Delivery::kTargetLocation:
+                                deliveryType = DeliveryType::TargetLocation;
+                                break;
+                            case RE::MagicSystem::Delivery::kTouch:
+                                deliveryType = DeliveryType::Touch;
+                                break;
+                            default:
+                                deliveryType = DeliveryType::None;
+                                break;
+                        }
+                    }
+                }
+
+                switch (spell->GetCastingType()) {
+                    case RE::MagicSystem::CastingType::kConcentration:
+                        attackType = AttackType::Continuous;
+                        break;
+                    case RE::MagicSystem::CastingType::kFireAndForget:
+                        attackType = AttackType::FireAndForget;
+                        break;
+                    case RE::MagicSystem::CastingType::kConstantEffect:
+                        attackType = AttackType::Constant;
+                        break;
+                    case RE::MagicSystem::CastingType::kScroll:
+                        weaponType = WeaponType::Scroll;
+                        break;
+                    default:
+                        break;
+                }
+            }
+
+            else if (auto* weapon = hitSourceForm->As<RE::TESObjectWEAP>()) {
+                weaponType = GetWeaponType(weapon);
+                attackSource = weapon;
+            }
+        }
+
+        RuleContext ctx{ 
+            EventType::kHit,
+            source,
+            targetRef, 
+            attackSource,
+            projectileSource,
+            weaponType,
+            attackType,
+            deliveryType,
+            true
+        };
+        
+        batch.push_back(ctx);
+    }
+
+    static void NormalizeMagicEffectApply(const EventRecord& record, std::vector<RuleContext>& batch)
+    {
+        auto* targetRef = RE::TESForm::LookupByID<RE::TESObjectREFR>(record.target);
+        auto* magicEffect = RE::TESForm::LookupByID<RE::EffectSetting>(record.form);
+        auto* caster = RE::TESForm::LookupByID<RE::Actor>(record.source);
+        
+        if (!EventSinkBase::IsItemSafe(targetRef)) return;
+        if (!magicEffect) return;
+		if (!EventSinkBase::IsActorSafe(caster)) return;
+
+        RE::TESForm* attackSource = magicEffect;
+        RE::TESForm* projectileSource = nullptr;
+        WeaponType weaponType = WeaponType::Other;
+        AttackType attackType = AttackType::Regular;
+        DeliveryType deliveryType = DeliveryType::None;
+        bool isShout = false;
+        bool isSpell = false;
+
+        if (magicEffect->data.projectileBase) {
+            if (!magicEffect->data.projectileBase->As<RE::BGSExplosion>()) {
+				weaponType = WeaponType::Ranged;
+                attackSource = magicEffect->data.projectileBase;
+                projectileSource = magicEffect->data.projectileBase;
+            }
+        }
+
+        if (magicEffect->data.associatedForm && magicEffect->data.associatedForm->formType == RE::FormType::Shout) {
+            weaponType = WeaponType::Shout;
+            attackSource = magicEffect->data.associatedForm;
+            isShout = true;
+        }
+        
+        if (!isShout) {
+            auto* currentShout = caster->GetCurrentShout();
+            if (currentShout) {
+                for (int i = 0; i < RE::TESShout::VariationIDs::kTotal; ++i) {
+                    auto& variation = currentShout->variations[i];
+                    if (variation.spell) {
+                        for (auto* effect : variation.spell->effects) {
+                            if (effect && effect->baseEffect == magicEffect) {
+                                weaponType = WeaponType::Shout;
+                                attackSource = currentShout;
+                                isShout = true;
+                                break;
+                            }
+                        }
+                        if (isShout) break;
+                    }
+                }
+            }
+        }
+
+        if (!isShout) {
+            RE::SpellItem* sourceSpell = nullptr;
+
+            std::array<RE::MagicSystem::CastingSource, 4> castingSources = {
+                RE::MagicSystem::CastingSource::kInstant,
+                RE::MagicSystem::CastingSource::kLeftHand,
+                RE::MagicSystem::CastingSource::kOther,
+                RE::MagicSystem::CastingSource::kRightHand
+            };
+
+            for (auto castingSource : castingSources) {
+                if (auto* casterActor = caster->As<RE::Actor>()) {
+                    if (auto* magicCaster = casterActor->GetMagicCaster(castingSource)) {
+                        if (auto* currentSpell = magicCaster->currentSpell) {
+                            for (auto* effect : currentSpell->effects) {
+                                if (effect && effect->baseEffect == magicEffect) {
+                                    sourceSpell = currentSpell->As<RE::SpellItem>();
+                                    break;
+                                }
+                            }
+                            if (sourceSpell) break;
+                        }
+                    }
+                }
+            }
+
+            if (sourceSpell) {
+                weaponType = GetSpellType(sourceSpell);
+                attackSource = sourceSpell;
+                isSpell = true;
+            }
+        }
+
+        switch (magicEffect->data.castingType) {
+            case RE::MagicSystem::CastingType::kConcentration:
+                attackType = AttackType::Continuous;
+                break;
+            case RE::MagicSystem::CastingType::kFireAndForget:
+                attackType = AttackType::FireAndForget;
+                break;
+            case RE::MagicSystem::CastingType::kConstantEffect:
+                attackType = AttackType::Constant;
+                break;
+            case RE::MagicSystem::CastingType::kScroll:
+                weaponType = WeaponType::Scroll;
+                break;
+            default:
+                break;
+        }
+
+        switch (magicEffect->data.delivery) {
+            case RE::MagicSystem::Delivery::kSelf:
+                deliveryType = DeliveryType::Self;
+                break;
+            case RE::MagicSystem::Delivery::kAimed:
+                deliveryType = DeliveryType::Aimed;
+                break;
+            case RE::MagicSystem::Delivery::kTargetActor:
+                deliveryType = DeliveryType::TargetActor;
+                break;
+            case RE::MagicSystem::Delivery::kTargetLocation:
+                deliveryType = DeliveryType::TargetLocation;
+                break;
+            case RE::MagicSystem::Delivery::kTouch:
+                deliveryType = DeliveryType::Touch;
+                break;
+            case RE::MagicSystem::Delivery::kTotal:
+                deliveryType = DeliveryType::Total;
+                break;
+            default:
+                deliveryType = DeliveryType::None;
+                break;
+        }
+
+        RuleContext ctx{
+            EventType::kHit,
+            caster,
+            targetRef,
+            attackSource,
+            projectileSource,
+            weaponType,
+            attackType,
+            deliveryType,
+            true
+        };
+    
+        batch.push_back(ctx);
+    }
+
+    static void NormalizeGrab(const EventRecord& record, std::vector<RuleContext>& batch)
+    {
+        auto* source = RE::TESForm::LookupByID<RE::Actor>(record.source);
+        auto* targetRef = RE::TESForm::LookupByID<RE::TESObjectREFR>(record.target);
+        if (!EventSinkBase::IsActorSafe(source) || !EventSinkBase::IsItemSafe(targetRef)) return;
+
+        batch.push_back(RuleContext{
+            EventType::kGrab,
+            source,
+            targetRef,
+            targetRef->GetBaseObject()
+        });
+    }
+
+    static void NormalizeRelease(const EventRecord& record, std::vector<RuleContext>& batch)
+    {
+        auto* source = RE::TESForm::LookupByID<RE::Actor>(record.source);
+        auto* targetRef = RE::TESForm::LookupByID<RE::TESObjectREFR>(record.target);
+        if (!EventSinkBase::IsActorSafe(source) || !EventSinkBase::IsItemSafe(targetRef)) return;
+
+		bool isTelekinesis = false;
+        bool isThrown = false;
+
+        RE::TESForm* leftSpell = source->GetEquippedObject(true);
+        RE::TESForm* rightSpell = source->GetEquippedObject(false);
+            
+        RE::MagicItem* leftMagicItem = leftSpell ? leftSpell->As<RE::MagicItem>() : nullptr;
+        RE::MagicItem* rightMagicItem = rightSpell ? rightSpell->As<RE::MagicItem>() : nullptr;
+            
+        if ((leftSpell || rightSpell) && (leftMagicItem || rightMagicItem)) {
+            bool hasGrabEffect = false;
+            for (auto* spell : { leftMagicItem, rightMagicItem }) {
+                if (spell) {
+                    for (auto* effect : spell->effects) {
+                        if (effect && effect->baseEffect) {
+                            if (effect->baseEffect->data.archetype == RE::EffectArchetypes::ArchetypeID::kTelekinesis ||
+                                effect->baseEffect->data.archetype == RE::EffectArchetypes::ArchetypeID::kGrabActor) {
+                                hasGrabEffect = true;
+                                break;
+                            }
+                        }
+                    }
+                }
+                if (hasGrabEffect) break;
+            }
+            isTelekinesis = hasGrabEffect;
+        }
+
+        auto* inputHandler = InputHandler::GetSingleton();
+        bool wasRKeyReleased = inputHandler->WasKeyJustReleased();
+            
+        if (auto threedimObj = targetRef->Get3D()) {
+            if (auto collisionObj = threedimObj->GetCollisionObject()) {
+                if (auto bhkBody = collisionObj->GetRigidBody()) {
+                    if (auto hkpBody = bhkBody->GetRigidBody()) {
+                        if (isTelekinesis || (!isTelekinesis && wasRKeyReleased)) {
+                            int propertyId = isTelekinesis ? 314159 : 628318; // HK_PROPERTY_TELEKINESIS : HK_PROPERTY_GRABTHROWNOBJECT
+                                
+                            if (hkpBody->HasProperty(propertyId)) {
+                                float now = duration_cast<duration<float>>(steady_clock::now() - startTime).count();
+                                hkpBody->SetProperty(propertyId, now);
+                            }
+                                
+                            hkpBody->AddContactListener(LandingSink::GetSingleton());
+                        }
+                            
+                        if (wasRKeyReleased) {
+                            isThrown = true;
+                            InputHandler::GetSingleton()->ResetKeyState();
+                        }
+                    }
+                }
+            }
+        }
+        if (!isThrown) {
+            RuleContext ctx{
+                EventType::kRelease,
+                source,
+				targetRef,
+				targetRef->GetBaseObject()
+            };
+            batch.push_back(ctx);
+        }
+    }
+
+	static void NormalizeExplosion(const EventRecord& record, std::vector<RuleContext>& batch)
+	{
+		RE::Actor* actor = nullptr;
+		if (record.source != 0) actor = RE::TESForm::LookupByID<RE::Actor>(record.source);
+		if (!EventSinkBase::IsActorSafe(actor)) return;
+
+		RE::TESForm* attackSource = nullptr;
+		if (record.form != 0) attackSource = RE::TESForm::LookupByID(record.form);
+
+		RE::TESObjectCELL* cell = nullptr;
+		if (record.extra != 0) {
+			cell = RE::TESForm::LookupByID<RE::TESObjectCELL>(record.extra);
+		} else {
+			if (actor) cell = actor->GetParentCell();
+			if (!cell) {
+				if (auto* player = RE::PlayerCharacter::GetSingleton()) cell = player->GetParentCell();
+			}
+		}
+		if (!cell) return;
+
+		const RE::NiPoint3 explosionPos{ record.position[0], record.position[1], record.position[2] };
+		cell->ForEachReferenceInRange(explosionPos, record.radius, [&](RE::TESObjectREFR* ref) -> RE::BSContainer::ForEachResult 
+		{
+			batch.push_back(RuleContext{
+				EventType::kHit,
+				actor,
+				ref,
+				attackSource,
+				nullptr,
+				WeaponType::Explosion,
+				AttackType::Regular,
+				DeliveryType::None,
+				true
+			});
+
+			return RE::BSContainer::ForEachResult::kContinue;
+		});
+	}
+
+	static void NormalizeProjectileImpact(const EventRecord& record, std::vector<RuleContext>& batch)
+	{
+		auto* actor = RE::TESForm::LookupByID<RE::Actor>(record.source);
+		if (!EventSinkBase::IsActorSafe(actor)) return;
+
+		auto* cell = RE::TESForm::LookupByID<RE::TESObjectCELL>(record.extra);
+		if (!cell) return;
+
+		RE::TESForm* projectileSource = record.target ? RE::TESForm::LookupByID(record.target) : nullptr;
+		RE::TESForm* attackSource = record.form ? RE::TESForm::LookupByID(record.form) : nullptr;
+		if (!attackSource) attackSource = projectileSource;
+
+		WeaponType weaponType = WeaponType::Ranged;
+		AttackType attackType = AttackType::Regular;
+		DeliveryType deliveryType = DeliveryType::None;
+
+		if (auto* spell = attackSource ? attackSource->As<RE::SpellItem>() : nullptr) {
+			weaponType = GetSpellType(spell);
+
+			switch (spell->data.castingType) {
+			case RE::MagicSystem::CastingType::kConcentration:
+				attackType = AttackType::Continuous;
+				break;
+			case RE::MagicSystem::CastingType::kFireAndForget:
+				attackType = AttackType::FireAndForget;
+				break;
+			case RE::MagicSystem::CastingType::kConstantEffect:
+				attackType = AttackType::Constant;
+				break;
+			case RE::MagicSystem::CastingType::kScroll:
+				weaponType = WeaponType::Scroll;
+				break;
+			default:
+				break;
+			}
+
+			switch (spell->data.delivery) {
+			case RE::MagicSystem::Delivery::kSelf:
+				deliveryType = DeliveryType::Self;
+				break;
+			case RE::MagicSystem::Delivery::kAimed:
+				deliveryType = DeliveryType::Aimed;
+				break;
+			case RE::MagicSystem::Delivery::kTargetActor:
+				deliveryType = DeliveryType::TargetActor;
+				break;
+			case RE::MagicSystem::Delivery::kTargetLocation:
+				deliveryType = DeliveryType::TargetLocation;
+				break;
+			case RE::MagicSystem::Delivery::kTouch:
+				deliveryType = DeliveryType::Touch;
+				break;
+			case RE::MagicSystem::Delivery::kTotal:
+				deliveryType = DeliveryType::Total;
+				break;
+			default:
+				deliveryType = DeliveryType::None;
+				break;
+			}
+		} else if (auto* weapon = attackSource ? attackSource->As<RE::TESObjectWEAP>() : nullptr) {
+			weaponType = GetWeaponType(weapon);
+
+			if (auto* actorState = actor->GetActorRuntimeData().currentProcess) {
+				if (auto& highData = actorState->high) {
+					if (auto& attackData = highData->attackData) {
+						attackType = GetAttackType(attackData.get());
+					}
+				}
+			}
+		} else if (attackSource && attackSource->As<RE::BGSExplosion>()) {
+			weaponType = WeaponType::Explosion;
+		}
+
+		const RE::NiPoint3 hitPos{ record.position[0], record.position[1], record.position[2] };
+		cell->ForEachReferenceInRange(hitPos, record.radius, [&](RE::TESObjectREFR* ref) {
+			if (!EventSinkBase::IsItemSafe(ref)) return RE::BSContainer::ForEachResult::kContinue;
+			auto* baseObj = ref->GetBaseObject();
+			if (!baseObj) return RE::BSContainer::ForEachResult::kContinue;
+
+			switch (baseObj->GetFormType()) {
+			case RE::FormType::Activator:  // For some activators with bad collision (e.g., some levers can't be hit by arrows)
+			case RE::FormType::Flora:
+			case RE::FormType::Tree:
+				break;
+			default:
+				return RE::BSContainer::ForEachResult::kContinue;
+			}
+
+			batch.push_back(RuleContext{
+				EventType::kHit,
+				actor,
+				ref,
+				attackSource,
+				projectileSource,
+				weaponType,
+				attackType,
+				deliveryType,
+				true
+			});
+			return RE::BSContainer::ForEachResult::kContinue;
+		});
+	}
+
+	static void NormalizeLanding(const EventRecord& record, std::vector<RuleContext>& batch)
+	{
+		auto* refr = RE::TESForm::LookupByID<RE::TESObjectREFR>(record.target);
+		if (!refr || refr->IsDeleted() || record.event == EventType::kNone) return;
+
+		batch.push_back(RuleContext{
+			record.event,
+			RE::PlayerCharacter::GetSingleton()->As<RE::Actor>(),
+			refr,
+			refr->GetBaseObject()
+		});
+	}
+
+	static void NormalizeCellAttachDetach(const EventRecord& record, std::vector<RuleContext>& batch)
+	{
+		auto* targetRef = RE::TESForm::LookupByID<RE::TESObjectREFR>(record.target);
+		if (!EventSinkBase::IsItemSafe(targetRef)) return;
+
+		batch.push_back(RuleContext{
+			record.origin == EventOrigin::kCellAttach ? EventType::kCellAttach : EventType::kCellDetach,
+			RE::PlayerCharacter::GetSingleton()->As<RE::Actor>(),
+			targetRef,
+			targetRef->GetBaseObject()
+		});
+	}
+
+	static void NormalizeDestructionStage(const EventRecord& record, std::vector<RuleContext>& batch)
+	{
+		auto* targetRef = RE::TESForm::LookupByID<RE::TESObjectREFR>(record.target);
+		if (!EventSinkBase::IsItemSafe(targetRef)) return;
+
+		batch.push_back(RuleContext{
+			EventType::kDestructionStageChange,
+			RE::PlayerCharacter::GetSingleton()->As<RE::Actor>(),
+			targetRef,
+			nullptr,
+			nullptr,
+			WeaponType::Other,
+			AttackType::Regular,
+			DeliveryType::None,
+			true,
+			nullptr,
+			record.stage
+		});
+	}
+
+	// One drain of the event queue: all records become contexts first and are evaluated as a single batch
+	static void ProcessQueuedEvents(std::span<const EventRecord> records)
+	{
+		// Reuse the thread's buffer without breaking if a drain ever runs from inside a triggered effect
+		static thread_local std::vector<RuleContext> batchBuffer;
+		std::vector<RuleContext> batch;
+		batch.swap(batchBuffer);
+		batch.clear();
+
+		for (const auto& record : records) {
+			switch (record.origin) {
+			case EventOrigin::kActivate:         NormalizeActivate(record, batch);         break;
+			case EventOrigin::kHit:              NormalizeHit(record, batch);              break;
+			case EventOrigin::kMagicEffectApply: NormalizeMagicEffectApply(record, batch); break;
+			case EventOrigin::kGrab:             NormalizeGrab(record, batch);             break;
+			case EventOrigin::kRelease:          NormalizeRelease(record, batch);          break;
+			case EventOrigin::kLanding:          NormalizeLanding(record, batch);          break;
+			case EventOrigin::kCellAttach:
+			case EventOrigin::kCellDetach:       NormalizeCellAttachDetach(record, batch); break;
+			case EventOrigin::kDestructionStage: NormalizeDestructionStage(record, batch); break;
+			case EventOrigin::kExplosion:        NormalizeExplosion(record, batch);        break;
+			case EventOrigin::kProjectileImpact: NormalizeProjectileImpact(record, batch); break;
+			case EventOrigin::kWeatherChange:
+				// Weather changes scan the whole cell, its references join the batch in record order
+				if (auto* weather = RE::TESForm::LookupByID<RE::TESWeather>(record.form)) {
+					CollectCellContexts(RE::PlayerCharacter::GetSingleton(), EventType::kWeatherChange, weather, batch);
+				}
+				break;
+			default:
+				break;
+			}
+		}
+
+		if (!batch.empty()) RuleManager::GetSingleton()->TriggerBatch(batch);
+
+		batch.clear();
+		batch.swap(batchBuffer);
+	}
+
 
 //██████╗░███████╗░██████╗░██╗░██████╗████████╗██████╗░░█████╗░████████╗██╗░█████╗░███╗░░██╗
 //██╔══██╗██╔════╝██╔════╝░██║██╔════╝╚══██╔══╝██╔══██╗██╔══██╗╚══██╔══╝██║██╔══██╗████╗░██║
@@ -1526,28 +1622,56 @@ namespace OIF
 //██║░░██║███████╗╚██████╔╝██║██████╔╝░░░██║░░░██║░░██║██║░░██║░░░██║░░░██║╚█████╔╝██║░╚███║
 //╚═╝░░╚═╝╚══════╝░╚═════╝░╚═╝╚═════╝░░░░╚═╝░░░╚═╝░░╚═╝╚═╝░░╚═╝░░░╚═╝░░░╚═╝░╚════╝░╚═╝░░╚══╝                                  
 
+    // Each instantiation remembers on its own whether it already attached its sink or hook
+    template <class Event, class Sink>
+    static void RegisterSink(std::uint32_t eventMask)
+    {
+        static bool registered = false;
+        if (registered || !RuleManager::GetSingleton()->HasRulesFor(eventMask)) return;
+
+        RE::ScriptEventSourceHolder::GetSingleton()->GetEventSource<Event>()->AddEventSink(Sink::GetSingleton());
+        registered = true;
+    }
+
+    // A zero mask means the hook is always needed
+    template <class Hook>
+    static bool ClaimHook(std::uint32_t eventMask)
+    {
+        static bool installed = false;
+        if (installed || (eventMask && !RuleManager::GetSingleton()->HasRulesFor(eventMask))) return false;
+
+        installed = true;
+        return true;
+    }
+
+    // Both run after every LoadRules: sources no loaded rule listens to stay detached, those needed by newly added rules are attached then
     void RegisterSinks()
     {
-        auto holder = RE::ScriptEventSourceHolder::GetSingleton();
-        holder->GetEventSource<RE::TESActivateEvent>()->AddEventSink(ActivateSink::GetSingleton());
-        holder->GetEventSource<RE::TESHitEvent>()->AddEventSink(HitSink::GetSingleton());
-        holder->GetEventSource<RE::TESGrabReleaseEvent>()->AddEventSink(GrabReleaseSink::GetSingleton());
-        holder->GetEventSource<RE::TESCellAttachDetachEvent>()->AddEventSink(CellAttachDetachSink::GetSingleton());
-        holder->GetEventSource<RE::TESMagicEffectApplyEvent>()->AddEventSink(MagicEffectApplySink::GetSingleton());
-        holder->GetEventSource<RE::TESDestructionStageChangedEvent>()->AddEventSink(DestructionStageChangedSink::GetSingleton());
+        EventQueue::GetSingleton()->SetConsumer(ProcessQueuedEvents);
+
+        RegisterSink<RE::TESActivateEvent, ActivateSink>(EventBit(EventType::kActivate));
+        RegisterSink<RE::TESHitEvent, HitSink>(EventBit(EventType::kHit));
+        RegisterSink<RE::TESGrabReleaseEvent, GrabReleaseSink>(kGrabReleaseEvents);
+        RegisterSink<RE::TESCellAttachDetachEvent, CellAttachDetachSink>(kCellAttachDetachEvents);
+        RegisterSink<RE::TESMagicEffectApplyEvent, MagicEffectApplySink>(EventBit(EventType::kHit));
+        RegisterSink<RE::TESDestructionStageChangedEvent, DestructionStageChangedSink>(EventBit(EventType::kDestructionStageChange));
 		
 		// Currently disabled, still in development
-		//holder->GetEventSource<RE::TESContainerChangedEvent>()->AddEventSink(DropSink::GetSingleton());
+		//RegisterSink<RE::TESContainerChangedEvent, DropSink>(EventBit(EventType::kDrop));
     }
 
     void InstallHooks() 
     {
-        REL::Relocation<std::uintptr_t> weatherChangeHook{ REL::VariantID(25684, 26231, 25684), REL::VariantOffset(0x44F, 0x46C, 0x44F) };
-        ::stl::write_thunk_call<WeatherChangeHook>(weatherChangeHook.address());
-		::stl::write_vfunc<RE::ReadyWeaponHandler, ReadyWeaponHook>();
-        ::stl::write_vfunc<RE::Explosion, ExplosionHook>();
-		::stl::write_vfunc<RE::PlayerCharacter, UpdateHook>();
-		::stl::write_vfunc<RE::AttackBlockHandler, AttackBlockHook>();
+        if (ClaimHook<WeatherChangeHook>(EventBit(EventType::kWeatherChange))) {
+            REL::Relocation<std::uintptr_t> weatherChangeHook{ REL::VariantID(25684, 26231, 25684), REL::VariantOffset(0x44F, 0x46C, 0x44F) };
+            ::stl::write_thunk_call<WeatherChangeHook>(weatherChangeHook.address());
+        }
+		if (ClaimHook<ReadyWeaponHook>(kReleaseEvents)) ::stl::write_vfunc<RE::ReadyWeaponHandler, ReadyWeaponHook>();
+        if (ClaimHook<ExplosionHook>(EventBit(EventType::kHit))) ::stl::write_vfunc<RE::Explosion, ExplosionHook>();
+		if (ClaimHook<AttackBlockHook>(EventBit(EventType::kHit))) ::stl::write_vfunc<RE::AttackBlockHandler, AttackBlockHook>();
+
+		// The player update drives the queues and timers, so it is installed whatever the rules
+		if (ClaimHook<UpdateHook>(0)) ::stl::write_vfunc<RE::PlayerCharacter, UpdateHook>();
 		
 		// Currently disabled due to instability issues
 		//::stl::write_vfunc<RE::MissileProjectile, MissileImpactHook>();
@@ -0,0 +1,23 @@
+#include "FrameDriver.h"
+
+namespace OIF {
+
+// ╔════════════════════════════════════╗
+// ║            FRAME DRIVER            ║
+// ╚════════════════════════════════════╝
+
+	void FrameDriver::Request()
+	{
+		if (!IsPaused() || _posted.exchange(true, std::memory_order_acq_rel)) return;
+		SKSE::GetTaskInterface()->AddTask([this]() { DrainWhilePaused(); });
+	}
+
+	void FrameDriver::DrainWhilePaused()
+	{
+		// Cleared first, so work queued while the drain runs posts the next task itself
+		_posted.store(false, std::memory_order_release);
+		if (!IsPaused()) return;																// the player update took over
+
+		if (_drain()) Request();
+	}
+}
@@ -1,6 +1,8 @@
 #include "RuleManager.h"
 #include "Effects.h"
+#include "Settings.h"
 #include <nlohmann/json.hpp>
+#include <bit>
 
 namespace fs = std::filesystem;
 using json = nlohmann::json;
@@ -76,29 +78,57 @@ namespace OIF {
         return it != formTypeMap.end() ? it->second : RE::FormType::None;
     }
 
-    static std::string MapAttackTypeToString(std::string_view s) {
-        static const std::unordered_set<std::string_view> validAttackTypes = {
-            "power", "bash", "charge", "rotating", "continuous", "constant", 
-            "fireandforget", "ignoreweapon", "overridedata"
+    static AttackType MapStringToAttackType(std::string_view s) {
+        static const std::unordered_map<std::string_view, AttackType> attackTypeMap = {
+            {"power", AttackType::Power}, {"bash", AttackType::Bash}, {"charge", AttackType::Charge},
+            {"rotating", AttackType::Rotating}, {"continuous", AttackType::Continuous}, {"constant", AttackType::Constant},
+            {"fireandforget", AttackType::FireAndForget}, {"ignoreweapon", AttackType::IgnoreWeapon}, {"overridedata", AttackType::OverrideData}
         };
-        return validAttackTypes.contains(s) ? std::string(s) : "regular";
+        auto it = attackTypeMap.find(s);
+        return it != attackTypeMap.end() ? it->second : AttackType::Regular;
     }
 
-    static std::string MapWeaponTypeToString(std::string_view s) {
-        static const std::unordered_set<std::string_view> validWeaponTypes = {
-            "onehandsword", "twohandsword", "onehandaxe", "twohandaxe",
-            "onehandmace", "twohandmace", "dagger", "ranged", "staff",
-            "spell", "scroll", "shout", "ability", "lesserpower", "power",
-            "explosion", "handtohand", "total"
+    static WeaponType MapStringToWeaponType(std::string_view s) {
+        static const std::unordered_map<std::string_view, WeaponType> weaponTypeMap = {
+            {"onehandsword", WeaponType::OneHandSword}, {"twohandsword", WeaponType::TwoHandSword},
+            {"onehandaxe", WeaponType::OneHandAxe}, {"twohandaxe", WeaponType::TwoHandAxe},
+            {"onehandmace", WeaponType::OneHandMace}, {"dagger", WeaponType::Dagger},
+            {"ranged", WeaponType::Ranged}, {"staff", WeaponType::Staff}, {"spell", WeaponType::Spell},
+            {"scroll", WeaponType::Scroll}, {"shout", WeaponType::Shout}, {"ability", WeaponType::Ability},
+            {"lesserpower", WeaponType::LesserPower}, {"power", WeaponType::Power},
+            {"explosion", WeaponType::Explosion}, {"handtohand", WeaponType::HandToHand}, {"total", WeaponType::Total}
         };
-        return validWeaponTypes.contains(s) ? std::string(s) : "other";
+        auto it = weaponTypeMap.find(s);
+        return it != weaponTypeMap.end() ? it->second : WeaponType::Other;
     }
 
-    static std::string MapDeliveryTypeToString(std::string_view s) {
-        static const std::unordered_set<std::string_view> validDeliveryTypes = {
-            "self", "aimed", "targetactor", "targetlocation", "touch", "total"
+    static DeliveryType MapStringToDeliveryType(std::string_view s) {
+        static const std::unordered_map<std::string_view, DeliveryType> deliveryTypeMap = {
+            {"self", DeliveryType::Self}, {"aimed", DeliveryType::Aimed}, {"targetactor", DeliveryType::TargetActor},
+            {"targetlocation", DeliveryType::TargetLocation}, {"touch", DeliveryType::Touch}, {"total", DeliveryType::Total}
         };
-        return validDeliveryTypes.contains(s) ? std::string(s) : "none";
+        auto it = deliveryTypeMap.find(s);
+        return it != deliveryTypeMap.end() ? it->second : DeliveryType::None;
+    }
+
+    static CompareOp MapStringToCompareOp(std::string_view s) {
+        if (s == ">=") return CompareOp::kGreaterEqual;
+        if (s == "<=") return CompareOp::kLessEqual;
+        if (s == ">") return CompareOp::kGreater;
+        if (s == "<") return CompareOp::kLess;
+        if (s == "=") return CompareOp::kEqual;
+        if (s == "!=") return CompareOp::kNotEqual;
+        return CompareOp::kNone;
+    }
+
+    static TimeField MapStringToTimeField(std::string_view s) {
+        static const std::unordered_map<std::string_view, TimeField> timeFieldMap = {
+            {"hour", TimeField::kHour}, {"minute", TimeField::kMinute}, {"day", TimeField::kDay},
+            {"month", TimeField::kMonth}, {"year", TimeField::kYear}, {"dayofweek", TimeField::kDayOfWeek},
+            {"gametime", TimeField::kGameTime}
+        };
+        auto it = timeFieldMap.find(s);
+        return it != timeFieldMap.end() ? it->second : TimeField::kNone;
     }
 
     RE::ActorValue GetActorValueFromString(const std::string& avName) {
@@ -255,26 +285,30 @@ namespace OIF {
 // ╚════════════════════════════════════╝
 
     template<typename T>
-    bool CompareValues(const std::string& op, T current, T target) {
-        if (op == ">=") return current >= target;
-        if (op == "<=") return current <= target;
-        if (op == ">") return current > target;
-        if (op == "<") return current < target;
-        if (op == "=") return current == target;
-        if (op == "!=") return current != target;
-        return false;
+    bool CompareValues(CompareOp op, T current, T target) {
+        switch (op) {
+            case CompareOp::kGreaterEqual: return current >= target;
+            case CompareOp::kLessEqual:    return current <= target;
+            case CompareOp::kGreater:      return current > target;
+            case CompareOp::kLess:         return current < target;
+            case CompareOp::kEqual:        return current == target;
+            case CompareOp::kNotEqual:     return current != target;
+            default:                       return false;
+        }
     }
 
     // Specialization for float, taking into account the error
     template<>
-    bool CompareValues<float>(const std::string& op, float current, float target) {
-        if (op == ">=") return current >= target;
-        if (op == "<=") return current <= target;
-        if (op == ">") return current > target;
-        if (op == "<") return current < target;
-        if (op == "=") return std::abs(current - target) < 0.001f;
-        if (op == "!=") return std::abs(current - target) >= 0.001f;
-        return false;
+    bool CompareValues<float>(CompareOp op, float current, float target) {
+        switch (op) {
+            case CompareOp::kGreaterEqual: return current >= target;
+            case CompareOp::kLessEqual:    return current <= target;
+            case CompareOp::kGreater:      return current > target;
+            case CompareOp::kLess:         return current < target;
+            case CompareOp::kEqual:        return std::abs(current - target) < 0.001f;
+            case CompareOp::kNotEqual:     return std::abs(current - target) >= 0.001f;
+            default:                       return false;
+        }
     }
 
 // ╔════════════════════════════════════╗
@@ -387,13 +421,15 @@ namespace OIF {
 		return fs::exists(dllPath);
 	}
 
-	bool HasItem(RE::Actor* actor, RE::FormID formID) {
-        if (!actor) return false;
+	bool HasAnyItem(RE::Actor* actor, const std::vector<RE::TESBoundObject*>& items) {
+        if (!actor || items.empty()) return false;
 
+        // Build the inventory once and probe it for every item
         auto inventory = actor->GetInventory();
         if (!inventory.empty()) {
-            for (const auto& [item, invData] : inventory) {
-                if (item && item->GetFormID() == formID && invData.first > 0) return true;
+            for (auto* item : items) {
+                auto it = inventory.find(item);
+                if (it != inventory.end() && it->second.first > 0) return true;
             }
         }
         return false;
@@ -425,7 +461,7 @@ namespace OIF {
 	}
 
     bool CheckActorValueCondition(const ActorValueCondition& condition, RE::Actor* actor) {
-        RE::ActorValue av = GetActorValueFromString(condition.actorValue);
+        RE::ActorValue av = condition.actorValue;
         if (av == RE::ActorValue::kNone) return false;
         
         auto* npc = actor->As<RE::TESNPC>();
@@ -440,46 +476,26 @@ namespace OIF {
         return CompareValues(condition.operator_type, currentLevel, condition.value);
     }
 
-    bool CheckTimeCondition(const TimeCondition& condition) {
-		RE::Calendar* calendar = nullptr;
-
-		try {
-			calendar = RE::Calendar::GetSingleton();
-		} catch (const std::exception& e) {
-			logger::error("Exception getting Calendar singleton: {}", e.what());
-			return false;
-		} catch (...) {
-			logger::error("Unknown exception getting Calendar singleton");
-			return false;
-		}
-
-        if (!calendar) return false;
+    bool CheckTimeCondition(const TimeCondition& condition, const WorldStateSnapshot& world) {
+        if (!world.calendarValid) return false;
         
         float currentValue = 0.0f;
-        std::string fieldLower = tolower_str(condition.field);
         
-        if (fieldLower == "hour") {
-            currentValue = calendar->GetHour();
-        } else if (fieldLower == "minute") {
-            currentValue = static_cast<float>(calendar->GetMinutes());
-        } else if (fieldLower == "day") {
-            currentValue = calendar->GetDay();
-        } else if (fieldLower == "month") {
-            currentValue = static_cast<float>(calendar->GetMonth());
-        } else if (fieldLower == "year") {
-            currentValue = static_cast<float>(calendar->GetYear());
-        } else if (fieldLower == "dayofweek") {
-            currentValue = static_cast<float>(calendar->GetDayOfWeek());
-        } else if (fieldLower == "gametime") {
-            currentValue = calendar->GetCurrentGameTime();
-        } else {
-            return false;
+        switch (condition.field) {
+            case TimeField::kHour:      currentValue = world.hour;      break;
+            case TimeField::kMinute:    currentValue = world.minute;    break;
+            case TimeField::kDay:       currentValue = world.day;       break;
+            case TimeField::kMonth:     currentValue = world.month;     break;
+            case TimeField::kYear:      currentValue = world.year;      break;
+            case TimeField::kDayOfWeek: currentValue = world.dayOfWeek; break;
+            case TimeField::kGameTime:  currentValue = world.gameTime;  break;
+            default:                    return false;
         }
         
         return CompareValues(condition.operator_type, currentValue, condition.value);
     }
 
-    bool CheckTimeFilters(const Filter& f) {
+    bool CheckTimeFilters(const Filter& f, const WorldStateSnapshot& world) {
         if (f.time.empty() && f.timeNot.empty()) {
             return true;
         }
@@ -488,7 +504,7 @@ namespace OIF {
         if (!f.time.empty()) {
             bool anyTimeMatch = false;
             for (const auto& condition : f.time) {
-                if (CheckTimeCondition(condition)) {
+                if (CheckTimeCondition(condition, world)) {
                     anyTimeMatch = true;
                     break;
                 }
@@ -499,7 +515,7 @@ namespace OIF {
         // Check excluding time filters
         if (!f.timeNot.empty()) {
             for (const auto& condition : f.timeNot) {
-                if (CheckTimeCondition(condition)) {
+                if (CheckTimeCondition(condition, world)) {
                     return false;
                 }
             }
@@ -508,7 +524,7 @@ namespace OIF {
         return true;
     }
 
-	bool CheckLocationFilter(const Filter& f, const RuleContext& ctx)
+	bool CheckLocationFilter(const Filter& f, const RuleContext& ctx, const LocationAncestry* ancestry)
 	{
 		// If there are no filters - skip the check
 		if (f.locations.empty() && f.locationsNot.empty()) return true;
@@ -528,75 +544,47 @@ namespace OIF {
 		}
 		RE::FormID currentWorldspaceID = currentWorldspace ? currentWorldspace->GetFormID() : 0;
 
-		// Collect all parent locations
-		std::set<RE::FormID> currentlocations;
-		std::set<RE::FormID> visitedParents;
-		if (currentLocation) {
-			currentlocations.insert(currentLocationID);
-			auto* parentLoc = currentLocation;
-			while (parentLoc && parentLoc->parentLoc) {
-				parentLoc = parentLoc->parentLoc;
-				if (visitedParents.contains(parentLoc->GetFormID())) {
-					logger::warn("Circular reference detected in location hierarchy");
-					break;
-				}
-				visitedParents.insert(parentLoc->GetFormID());
-				currentlocations.insert(parentLoc->GetFormID());
+		// Current location and all of its parents, precomputed after data load
+		std::span<const RE::FormID> currentLocations = ancestry ? ancestry->Get(currentLocation) : std::span<const RE::FormID>{};
+
+		auto matchesAny = [&](const std::unordered_set<RE::FormID>& ids) {
+			if ((currentCellID && ids.contains(currentCellID)) ||
+				(currentWorldspaceID && ids.contains(currentWorldspaceID)) ||
+				(currentLocationID && ids.contains(currentLocationID))) {
+				return true;
 			}
-		}
 
-		// Check including filters
-		if (!f.locations.empty()) {
-			bool matched = (currentCellID && f.locations.contains(currentCellID)) ||
-						   (currentWorldspaceID && f.locations.contains(currentWorldspaceID)) ||
-						   (currentLocationID && f.locations.contains(currentLocationID));
-
-			if (!matched) {
-				for (auto locID : currentlocations) {
-					if (f.locations.contains(locID)) {
-						matched = true;
-						break;
-					}
+			if (!currentLocations.empty()) {
+				for (auto locID : currentLocations) {
+					if (ids.contains(locID)) return true;
 				}
+				return false;
 			}
 
-			if (!matched) return false;
-		}
-
-		// Check excluding filters
-		if (!f.locationsNot.empty()) {
-			bool excluded = (currentCellID && f.locationsNot.contains(currentCellID)) ||
-							(currentWorldspaceID && f.locationsNot.contains(currentWorldspaceID)) ||
-							(currentLocationID && f.locationsNot.contains(currentLocationID));
-
-			if (!excluded) {
-				for (auto locID : currentlocations) {
-					if (f.locationsNot.contains(locID)) {
-						excluded = true;
-						break;
-					}
-				}
+			// Location unknown to the closure, walk the parent chain with a bounded depth instead
+			auto* parentLoc = currentLocation ? currentLocation->parentLoc : nullptr;
+			for (int depth = 0; parentLoc && depth < 64; ++depth, parentLoc = parentLoc->parentLoc) {
+				if (ids.contains(parentLoc->GetFormID())) return true;
 			}
+			return false;
+		};
 
-			if (excluded) return false;
-		}
+		// Check including filters
+		if (!f.locations.empty() && !matchesAny(f.locations)) return false;
+
+		// Check excluding filters
+		if (!f.locationsNot.empty() && matchesAny(f.locationsNot)) return false;
 
 		return true;
 	}
     
-    bool CheckWeatherFilter(const Filter& f) {
+    bool CheckWeatherFilter(const Filter& f, const WorldStateSnapshot& world) {
         if (f.weathers.empty() && f.weathersNot.empty()) return true;
 
-		auto* player = RE::PlayerCharacter::GetSingleton();
-		if (player) {
-			auto* cell = player->GetParentCell();
-			if (cell && cell->IsInteriorCell()) return true;  // If player is indoors, skip the weather check
-		}
+		if (world.playerInInterior) return true;  // If player is indoors, skip the weather check
+		if (!world.weatherID) return false;  // If weather data is unavailable, make sure Trigger is not executed
     
-        auto* sky = RE::Sky::GetSingleton();
-        if (!sky || !sky->currentWeather) return false;  // If weather data is unavailable, make sure Trigger is not executed
-    
-        RE::FormID currentWeatherID = sky->currentWeather->GetFormID();
+        RE::FormID currentWeatherID = world.weatherID;
 
         if (!f.weathers.empty()) {
             if (!f.weathers.contains(currentWeatherID)) return false;
@@ -609,50 +597,354 @@ namespace OIF {
         return true;
     }
 
+// ╔════════════════════════════════════╗
+// ║        WORLD STATE SNAPSHOT        ║
+// ╚════════════════════════════════════╝
+
+    void WorldStateSnapshot::Build(std::uint8_t parts) {
+        parts &= ~built;
+        if (!parts) return;
+
+        if (parts & kCalendar) {
+            auto* calendar = RE::Calendar::GetSingleton();
+            calendarValid = calendar != nullptr;
+            if (calendar) {
+                hour = calendar->GetHour();
+                minute = static_cast<float>(calendar->GetMinutes());
+                day = calendar->GetDay();
+                month = static_cast<float>(calendar->GetMonth());
+                year = static_cast<float>(calendar->GetYear());
+                dayOfWeek = static_cast<float>(calendar->GetDayOfWeek());
+                gameTime = calendar->GetCurrentGameTime();
+            }
+        }
+
+        if (parts & kSky) {
+            playerInInterior = false;
+            if (auto* player = RE::PlayerCharacter::GetSingleton()) {
+                auto* cell = player->GetParentCell();
+                playerInInterior = cell && cell->IsInteriorCell();
+            }
+
+            auto* sky = RE::Sky::GetSingleton();
+            weatherID = sky && sky->currentWeather ? sky->currentWeather->GetFormID() : 0;
+        }
+
+        if (parts & kCamera) {
+            auto* cam = RE::PlayerCamera::GetSingleton();
+            cameraValid = cam && cam->currentState && cam->currentState->camera;
+            if (cameraValid) {
+                const auto& states = cam->GetRuntimeData().cameraStates;
+                isFirstPerson = states[RE::CameraStates::kFirstPerson] || states[RE::CameraStates::kVR];	// (Hopefully)
+                isThirdPerson = states[RE::CameraStates::kThirdPerson] || states[RE::CameraStates::kVRThirdPerson];
+            }
+        }
+
+        if (parts & kPlayer) {
+            auto* player = RE::PlayerCharacter::GetSingleton();
+            playerValid = player != nullptr;
+            if (player) {
+                if (auto* root = player->Get3D()) {
+                    playerCenter = root->worldBound.center;
+                } else {
+                    const auto& pmin = player->GetBoundMin();
+                    const auto& pmax = player->GetBoundMax();
+                    playerCenter = {
+                        (pmin.x + pmax.x) * 0.5f,
+                        (pmin.y + pmax.y) * 0.5f,
+                        (pmin.z + pmax.z) * 0.5f
+                    };
+                }
+            }
+        }
+
+        built |= parts;
+    }
+
+    const WorldStateSnapshot& RuleManager::GetWorldState(std::uint8_t parts) const {
+        static thread_local WorldStateSnapshot world;
+
+        auto frame = _frame.load(std::memory_order_relaxed);
+        if (world.frame != frame) {
+            world.frame = frame;
+            world.built = 0;
+        }
+
+        world.Build(parts);
+        return world;
+    }
+
+// ╔════════════════════════════════════╗
+// ║           COUNTER TABLE            ║
+// ╚════════════════════════════════════╝
+
+    std::uint32_t CounterTable::Now() {
+        static const auto start = std::chrono::steady_clock::now();
+        return static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    std::size_t CounterTable::Hash(std::uint64_t refs, std::uint16_t rule) {
+        // splitmix64 finalizer, form IDs of one plugin share their high byte
+        std::uint64_t h = refs ^ (static_cast<std::uint64_t>(rule) * 0x9E3779B97F4A7C15ull);
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+        return static_cast<std::size_t>(h ^ (h >> 31));
+    }
+
+    bool CounterTable::IsDetached(const Entry& entry) {
+        auto* ref = RE::TESForm::LookupByID<RE::TESObjectREFR>(static_cast<RE::FormID>(entry.refs));
+        if (!ref) return true;
+        auto* cell = ref->GetParentCell();
+        return !cell || !cell->IsAttached();
+    }
+
+    std::size_t CounterTable::Find(std::uint64_t refs, std::uint16_t rule) const {
+        if (_slots.empty()) return npos;
+
+        const std::size_t mask = _slots.size() - 1;
+        for (std::size_t slot = Hash(refs, rule) & mask; _slots[slot].used; slot = (slot + 1) & mask) {
+            if (_slots[slot].refs == refs && _slots[slot].rule == rule) return slot;
+        }
+        return npos;
+    }
+
+    void CounterTable::Grow() {
+        const std::size_t capacity = _slots.empty() ? 64 : _slots.size() * 2;
+        std::vector<Entry> old = std::exchange(_slots, std::vector<Entry>(capacity));
+        const std::size_t mask = _slots.size() - 1;
+        for (const auto& entry : old) {
+            if (!entry.used) continue;
+            std::size_t slot = Hash(entry.refs, entry.rule) & mask;
+            while (_slots[slot].used) slot = (slot + 1) & mask;
+            _slots[slot] = entry;
+        }
+        _hand = 0;
+    }
+
+    void CounterTable::EraseSlot(std::size_t slot) {
+        // Backward-shift deletion keeps probe chains intact without tombstones
+        const std::size_t mask = _slots.size() - 1;
+        std::size_t hole = slot;
+        for (std::size_t next = (hole + 1) & mask; _slots[next].used; next = (next + 1) & mask) {
+            const std::size_t home = Hash(_slots[next].refs, _slots[next].rule) & mask;
+            const bool stays = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+            if (stays) continue;
+            _slots[hole] = _slots[next];
+            hole = next;
+        }
+        _slots[hole] = Entry{};
+        --_size;
+    }
+
+    void CounterTable::EvictOne(std::uint32_t now) {
+        if (_size == 0) return;
+
+        // Approximate LRU over a small window: spent counters and detached references go first, then the oldest
+        const std::size_t mask = _slots.size() - 1;
+        std::size_t victim = npos;
+        std::uint32_t victimAge = 0;
+        std::size_t scanned = 0;
+        for (std::size_t n = 0; n < _slots.size() && scanned < kEvictWindow; ++n) {
+            const std::size_t slot = (_hand + n) & mask;
+            const auto& entry = _slots[slot];
+            if (!entry.used) continue;
+            ++scanned;
+            if (entry.value == 0 || IsDetached(entry)) {
+                victim = slot;
+                break;
+            }
+            const std::uint32_t age = now - entry.touched;
+            if (victim == npos || age > victimAge) {
+                victim = slot;
+                victimAge = age;
+            }
+        }
+        _hand = (_hand + kEvictWindow) & mask;
+
+        if (victim != npos) EraseSlot(victim);
+    }
+
+    std::uint32_t& CounterTable::Touch(const Key& key, std::uint32_t now) {
+        const std::uint64_t refs = Pack(key);
+        std::size_t slot = Find(refs, key.ruleIdx);
+        if (slot == npos) {
+            if (_maxEntries && _size >= _maxEntries) {
+                if (_evictLive) {
+                    EvictOne(now);
+                } else if (!_capWarned) {
+                    _capWarned = true;
+                    logger::warn("Counter table reached its {} KB memory cap, live counters are kept and the table grows past it", _maxEntries * 8 / 3 * sizeof(Entry) / 1024);
+                }
+            }
+            if ((_size + 1) * 4 > _slots.size() * 3) Grow();
+
+            const std::size_t mask = _slots.size() - 1;
+            slot = Hash(refs, key.ruleIdx) & mask;
+            while (_slots[slot].used) slot = (slot + 1) & mask;
+            _slots[slot] = Entry{ refs, key.ruleIdx, true, 0, now };
+            ++_size;
+        }
+        _slots[slot].touched = now;
+        return _slots[slot].value;
+    }
+
+    void CounterTable::Set(const Key& key, std::uint32_t value, std::uint32_t now) {
+        Touch(key, now) = value;
+    }
+
+    void CounterTable::Clear() {
+        _slots.clear();
+        _size = 0;
+        _hand = 0;
+    }
+
+    void CounterTable::SetMemoryCap(std::size_t bytes, bool evictLive) {
+        // 3/8 of the slot count keeps the power-of-two table at 0.75 load within the cap
+        _maxEntries = bytes ? std::max<std::size_t>(bytes / sizeof(Entry) * 3 / 8, 16) : 0;
+        _evictLive = evictLive;
+        _capWarned = false;
+    }
+
+    std::size_t CounterTable::Maintain(std::uint32_t now, std::uint32_t maxAge, std::size_t slotBudget) {
+        if (_size == 0) return 0;
+
+        const bool pressure = _evictLive && _maxEntries && _size * 8 >= _maxEntries * 7;
+        const std::size_t mask = _slots.size() - 1;
+        std::size_t removed = 0;
+
+        for (std::size_t n = 0; n < slotBudget && _size > 0; ++n) {
+            const std::size_t slot = _hand & mask;
+            const auto& entry = _slots[slot];
+            if (entry.used &&
+                (entry.value == 0 ||
+                 (maxAge && now - entry.touched > maxAge) ||
+                 (pressure && IsDetached(entry)))) {
+                EraseSlot(slot);                                            // a shifted entry may now occupy this slot, check it again
+                ++removed;
+                continue;
+            }
+            _hand = (slot + 1) & mask;
+        }
+
+        // The cap was lowered below the current size
+        while (_evictLive && _maxEntries && _size > _maxEntries && removed < slotBudget) {
+            EvictOne(now);
+            ++removed;
+        }
+        return removed;
+    }
+
 // ╔════════════════════════════════════╗
 // ║       SERIALIZATION HELPERS        ║
 // ╚════════════════════════════════════╝
 
     void RuleManager::ResetInteractionCounts()
     {
-        std::unique_lock lock(_ruleMutex);
-        _limitCounts.clear();
-        _interactionsCounts.clear();
+        std::lock_guard lock(_counterMutex);
+        _limitCounts.Clear();
+        _interactionsCounts.Clear();
     }
     
+    // 'LCNT' layouts: 2 - raw Key structs keyed by rule index, 3 - one varint blob keyed by stable rule IDs
+    static constexpr std::uint32_t kLimitRecordVersion = 3;
+
     void RuleManager::OnSave(SKSE::SerializationInterface* intf)
     {
-        std::shared_lock lock(_ruleMutex);
-    
-        if (!intf->OpenRecord('LCNT', 2)) // 'LCNT' for Limit Counts
-            return;
-    
-        std::uint32_t limitSize = static_cast<std::uint32_t>(_limitCounts.size());
-        intf->WriteRecordData(limitSize);
-    
-        for (auto& [key, val] : _limitCounts) {
-            intf->WriteRecordData(&key, sizeof(key));
-            intf->WriteRecordData(&val, sizeof(val));
+        auto ruleSet = GetRuleSet();
+        std::vector<SavedCount> counts;
+        {
+            std::lock_guard lock(_counterMutex);
+            counts.reserve(_limitCounts.Size());
+            if (ruleSet) {
+                _limitCounts.ForEach([&](const Key& key, std::uint32_t val) {
+                    if (val && key.ruleIdx < ruleSet->rules.size()) {
+                        counts.push_back({ ruleSet->rules[key.ruleIdx].stableID, key.sourceID, key.targetID, val });
+                    }
+                });
+            }
         }
+
+        const auto data = CounterCodec::Encode(counts);
+
+        if (!intf->OpenRecord('LCNT', kLimitRecordVersion)) // 'LCNT' for Limit Counts
+            return;
+
+        intf->WriteRecordData(data.data(), static_cast<std::uint32_t>(data.size()));
     }
     
     void RuleManager::OnLoad(SKSE::SerializationInterface* intf)
     {
         ResetInteractionCounts();
+
+        // Saved counters are matched to the rules of the current snapshot
+        auto ruleSet = GetRuleSet();
+        const std::size_t ruleCount = ruleSet ? ruleSet->rules.size() : 0;
+        std::unordered_map<std::uint32_t, std::uint16_t> ruleIndex;
+        ruleIndex.reserve(ruleCount);
+        for (std::size_t i = 0; i < ruleCount; ++i) {
+            ruleIndex.emplace(ruleSet->rules[i].stableID, static_cast<std::uint16_t>(i));
+        }
+
+        std::lock_guard lock(_counterMutex);
     
+        const std::uint32_t now = CounterTable::Now();
+        std::size_t dropped = 0;
         std::uint32_t type, version, length;
         while (intf->GetNextRecordInfo(type, version, length)) {
-            if (type == 'LCNT') {
-                std::uint32_t size;
-                intf->ReadRecordData(size);
+            if (type != 'LCNT') continue;
+
+            if (version == kLimitRecordVersion) {
+                std::vector<std::uint8_t> data(length);
+                if (length && intf->ReadRecordData(data.data(), length) != length) {
+                    logger::error("Limit counter record is truncated, saved limits were discarded");
+                    continue;
+                }
+
+                std::vector<SavedCount> counts;
+                if (!CounterCodec::Decode(data, counts)) {
+                    logger::error("Limit counter record is malformed, saved limits were discarded");
+                    continue;
+                }
+
+                for (const auto& c : counts) {
+                    auto it = ruleIndex.find(c.ruleID);
+                    if (it == ruleIndex.end()) {
+                        ++dropped;
+                        continue;
+                    }
+                    _limitCounts.Set(Key{ c.sourceID, c.targetID, it->second }, c.value, now);
+                }
+            } else if (version == 2) {
+                // Legacy layout has no rule identity, its indices are taken to match the current load order
+                std::uint32_t size = 0;
+                if (intf->ReadRecordData(&size, sizeof(size)) != sizeof(size)) {
+                    logger::error("Legacy limit counter record is truncated, saved limits were discarded");
+                    continue;
+                }
+
+                std::size_t migrated = 0;
                 for (std::uint32_t i = 0; i < size; ++i) {
                     Key key; std::uint32_t val;
-                    intf->ReadRecordData(&key, sizeof(key));
-                    intf->ReadRecordData(&val, sizeof(val));
-                    _limitCounts[key] = val;
+                    if (intf->ReadRecordData(&key, sizeof(key)) != sizeof(key) || intf->ReadRecordData(&val, sizeof(val)) != sizeof(val)) {
+                        logger::error("Legacy limit counter record is truncated after {} of {} entries, the rest were discarded", i, size);
+                        break;
+                    }
+                    if (key.ruleIdx >= ruleCount) {
+                        ++dropped;
+                        continue;
+                    }
+                    _limitCounts.Set(key, val, now);
+                    ++migrated;
                 }
+                logger::info("Migrated {} limit counters from the legacy co-save layout", migrated);
+            } else {
+                logger::warn("Unknown limit counter record version {}, saved limits were discarded", version);
             }
         }
+
+        if (dropped) {
+            logger::info("{} saved limit counters belong to rules that no longer exist and were dropped", dropped);
+        }
     }
 
     void RuleManager::InitSerialization()
@@ -668,55 +960,598 @@ namespace OIF {
             });
             ser->SetRevertCallback([](auto*) {
                 GetSingleton()->ResetInteractionCounts();
+                // Delays and effects queued in the previous session must not fire into the next one
+                Scheduler::GetSingleton()->CancelAll();
+                EffectQueue::GetSingleton()->Clear();
+                EventQueue::GetSingleton()->Clear();
             });
         }
     }
 
 
-//░██████╗░███████╗███╗░░██╗███████╗██████╗░░█████╗░██╗░░░░░
-//██╔════╝░██╔════╝████╗░██║██╔════╝██╔══██╗██╔══██╗██║░░░░░
-//██║░░██╗░█████╗░░██╔██╗██║█████╗░░██████╔╝███████║██║░░░░░
-//██║░░╚██╗██╔══╝░░██║╚████║██╔══╝░░██╔══██╗██╔══██║██║░░░░░
-//╚██████╔╝███████╗██║░╚███║███████╗██║░░██║██║░░██║███████╗
-//░╚═════╝░╚══════╝╚═╝░░╚══╝╚══════╝╚═╝░░╚═╝╚═╝░░╚═╝╚══════╝
+//░██████╗░███████╗███╗░░██╗███████╗██████╗░░█████╗░██╗░░░░░
+//██╔════╝░██╔════╝████╗░██║██╔════╝██╔══██╗██╔══██╗██║░░░░░
+//██║░░██╗░█████╗░░██╔██╗██║█████╗░░██████╔╝███████║██║░░░░░
+//██║░░╚██╗██╔══╝░░██║╚████║██╔══╝░░██╔══██╗██╔══██║██║░░░░░
+//╚██████╔╝███████╗██║░╚███║███████╗██║░░██║██║░░██║███████╗
+//░╚═════╝░╚══════╝╚═╝░░╚══╝╚══════╝╚═╝░░╚═╝╚═╝░░╚═╝╚══════╝
+
+// ╔════════════════════════════════════╗
+// ║             SINGLETON              ║
+// ╚════════════════════════════════════╝
+
+    RuleManager* RuleManager::GetSingleton() {
+        static RuleManager inst;
+        return &inst;
+    }
+
+// ╔════════════════════════════════════╗
+// ║           LOADING RULES            ║
+// ╚════════════════════════════════════╝
+
+    void RuleManager::LoadRules() {
+
+        std::lock_guard loadLock(_loadMutex);
+        auto ruleSet = std::make_shared<RuleSet>();
+        
+        const fs::path dir{ "Data/SKSE/Plugins/ObjectImpactFramework" };
+        if (!fs::exists(dir)) {
+            logger::error("Rules directory does not exist: {}", dir.string());
+        } else {
+            try {
+                for (auto const& entry : fs::recursive_directory_iterator{ dir }) {
+                    if (entry.is_regular_file() && entry.path().extension() == ".json") {
+                        ParseJSON(entry.path(), ruleSet->rules);
+                    }
+                }
+            } catch (const fs::filesystem_error& e) {
+                logger::error("Filesystem error while loading rules: {}", e.what());
+            }
+        }
+
+        AssignStableIDs(*ruleSet);
+
+        std::vector<RE::FormID> unresolved;
+        for (auto& rule : ruleSet->rules) {
+            ResolveFilterForms(rule, unresolved);
+            rule.compiled = CompileFilter(rule);
+        }
+
+        if (!unresolved.empty()) {
+            std::string ids;
+            for (std::size_t i = 0; i < unresolved.size() && i < 16; ++i) {
+                ids += std::format("{}{:08X}", i ? ", " : "", unresolved[i]);
+            }
+            logger::warn("{} filter forms could not be resolved and were dropped: {}{}", unresolved.size(), ids, unresolved.size() > 16 ? ", ..." : "");
+        }
+
+        auto previous = GetRuleSet();
+        ruleSet->locationAncestry = BuildLocationAncestry(previous ? previous->locationAncestry : nullptr);
+
+        AdvanceFrame();
+        FormListCache::GetSingleton()->Clear();
+        InitAdaptiveOrders(*ruleSet);
+        BuildKeywordMasks(*ruleSet);
+        BuildEventIndex(*ruleSet);
+        ruleSet->staticMatches->SetRules(ruleSet->rules, ruleSet->eventRules[static_cast<std::size_t>(EventType::kOnUpdate)].rules);
+        for (auto event : { EventType::kOnUpdate, EventType::kWeatherChange, EventType::kCellAttach, EventType::kCellDetach }) {
+            ruleSet->prefilters[static_cast<std::size_t>(event)] = BuildPrefilter(*ruleSet, event);
+        }
+
+        LogEventStatistics();
+        for (std::size_t evIdx = 0; evIdx < kEventTypeCount; ++evIdx) {
+            _eventTriggerCounts[evIdx].store(0, std::memory_order_relaxed);
+            _eventVisitedRuleCounts[evIdx].store(0, std::memory_order_relaxed);
+        }
+
+        {
+            std::lock_guard counterLock(_counterMutex);
+            _ruleRolls.assign(ruleSet->rules.size(), RuleRolls{});
+            RemapCounters(previous.get(), *ruleSet);
+
+            const std::size_t counterCap = static_cast<std::size_t>(Settings::GetSingleton()->counterMemoryCapKB) * 1024;
+            _limitCounts.SetMemoryCap(counterCap, false);											// a dropped limit counter would let its rule fire again
+            _interactionsCounts.SetMemoryCap(counterCap);
+            _updateTimers.SetMemoryCap(counterCap);
+        }
+
+        std::uint32_t listenedEvents = 0;
+        for (std::size_t evIdx = 0; evIdx < kEventTypeCount; ++evIdx) {
+            if (!ruleSet->eventRules[evIdx].rules.empty()) listenedEvents |= EventBit(static_cast<EventType>(evIdx));
+        }
+
+        logger::info("Total rules loaded: {}", ruleSet->rules.size());
+
+        // Publish the new snapshot, triggers in flight keep the previous one alive until they finish
+        _ruleSet.store(std::shared_ptr<const RuleSet>(std::move(ruleSet)), std::memory_order_release);
+        _listenedEvents.store(listenedEvents, std::memory_order_relaxed);
+    }
+
+    void RuleManager::AssignStableIDs(RuleSet& ruleSet) {
+        std::unordered_set<std::uint32_t> used;
+        used.reserve(ruleSet.rules.size());
+
+        // Identical rules within one file and rare hash collisions are told apart by load order
+        std::size_t collisions = 0;
+        for (auto& rule : ruleSet.rules) {
+            while (!used.insert(rule.stableID).second) {
+                rule.stableID = rule.stableID * 16777619u + 0x9E3779B9u;
+                ++collisions;
+            }
+        }
+        if (collisions) {
+            logger::debug("{} duplicate rule identities were disambiguated by load order", collisions);
+        }
+    }
+
+    void RuleManager::RemapCounters(const RuleSet* previous, const RuleSet& next) {
+        if (!previous || (_limitCounts.Size() == 0 && _interactionsCounts.Size() == 0 && _updateTimers.Size() == 0)) return;
+
+        std::unordered_map<std::uint32_t, std::uint16_t> nextIndex;
+        nextIndex.reserve(next.rules.size());
+        for (std::size_t i = 0; i < next.rules.size(); ++i) {
+            nextIndex.emplace(next.rules[i].stableID, static_cast<std::uint16_t>(i));
+        }
+
+        // Counters follow their rule to its new index, counters of removed rules are dropped
+        std::vector<int> oldToNew(previous->rules.size(), -1);
+        bool unchanged = previous->rules.size() == next.rules.size();
+        for (std::size_t i = 0; i < previous->rules.size(); ++i) {
+            if (auto it = nextIndex.find(previous->rules[i].stableID); it != nextIndex.end()) {
+                oldToNew[i] = it->second;
+            }
+            unchanged &= oldToNew[i] == static_cast<int>(i);
+        }
+        if (unchanged) return;
+
+        const std::uint32_t now = CounterTable::Now();
+        std::size_t dropped = 0;
+        const auto remap = [&](CounterTable& table) {
+            CounterTable remapped;
+            table.ForEach([&](const Key& key, std::uint32_t value) {
+                if (key.ruleIdx < oldToNew.size() && oldToNew[key.ruleIdx] >= 0) {
+                    remapped.Set(Key{ key.sourceID, key.targetID, static_cast<std::uint16_t>(oldToNew[key.ruleIdx]) }, value, now);
+                } else {
+                    ++dropped;
+                }
+            });
+            table = std::move(remapped);
+        };
+        remap(_limitCounts);
+        remap(_interactionsCounts);
+        remap(_updateTimers);
+
+        logger::info("Counters were remapped to the reloaded rules, {} counters of removed rules dropped", dropped);
+    }
+
+// ╔════════════════════════════════════╗
+// ║        FORMLIST MEMBERSHIP         ║
+// ╚════════════════════════════════════╝
+
+    FormListCache* FormListCache::GetSingleton() {
+        static FormListCache inst;
+        return &inst;
+    }
+
+    bool FormListCache::IsCurrent(const Entry& entry, const RE::BGSListForm* list) {
+        // Any add, remove or revert reallocates or resizes the array or changes the script-added count
+        return entry.data == list->forms.data() &&
+               entry.size == list->forms.size() &&
+               entry.scriptAdded == list->scriptAddedFormCount;
+    }
+
+    int FormListCache::IndexOf(const RE::BGSListForm* list, RE::FormID formID) {
+        if (!list) return -1;
+
+        {
+            std::shared_lock lock(_mutex);
+            if (auto it = _entries.find(list); it != _entries.end() && IsCurrent(it->second, list)) {
+                auto idx = it->second.indices.find(formID);
+                return idx != it->second.indices.end() ? idx->second : -1;
+            }
+        }
+
+        std::unique_lock lock(_mutex);
+        auto& entry = _entries[list];
+        if (!IsCurrent(entry, list)) {
+            entry.data = list->forms.data();
+            entry.size = list->forms.size();
+            entry.scriptAdded = list->scriptAddedFormCount;
+            entry.indices.clear();
+            entry.indices.reserve(list->forms.size());
+            for (std::uint32_t i = 0; i < list->forms.size(); ++i) {
+                if (auto* form = list->forms[i]) {
+                    entry.indices.try_emplace(form->GetFormID(), static_cast<int>(i));
+                }
+            }
+        }
+
+        auto idx = entry.indices.find(formID);
+        return idx != entry.indices.end() ? idx->second : -1;
+    }
+
+    void FormListCache::Clear() {
+        std::unique_lock lock(_mutex);
+        _entries.clear();
+    }
+
+// ╔════════════════════════════════════╗
+// ║          KEYWORD BITSETS           ║
+// ╚════════════════════════════════════╝
+
+    void KeywordIndex::Add(const std::set<RE::BGSKeyword*>& keywords) {
+        for (auto* kw : keywords) {
+            if (!kw) continue;
+            if (bits.try_emplace(kw, static_cast<std::uint32_t>(bits.size())).second) {
+                words = static_cast<std::uint32_t>((bits.size() + 63) / 64);
+            }
+        }
+    }
+
+    KeywordMask KeywordIndex::MakeMask(const std::set<RE::BGSKeyword*>& keywords) const {
+        std::vector<std::uint64_t> dense(words, 0);
+        for (auto* kw : keywords) {
+            if (auto it = bits.find(kw); it != bits.end()) {
+                dense[it->second / 64] |= 1ull << (it->second % 64);
+            }
+        }
+
+        KeywordMask mask;
+        for (std::uint32_t w = 0; w < words; ++w) {
+            if (dense[w]) mask.words.emplace_back(w, dense[w]);
+        }
+        return mask;
+    }
+
+    bool KeywordSetCache::HasAny(const KeywordIndex& index, const RE::BGSKeywordForm* form, const KeywordMask& mask) {
+        if (!form || mask.words.empty()) return false;
+
+        auto test = [&mask](const Entry& entry) {
+            for (const auto& [w, bits] : mask.words) {
+                if (entry.bits[w] & bits) return true;
+            }
+            return false;
+        };
+
+        {
+            std::shared_lock lock(_mutex);
+            if (auto it = _entries.find(form); it != _entries.end() &&
+                it->second.keywords == form->keywords && it->second.count == form->numKeywords) {
+                return test(it->second);
+            }
+        }
+
+        // First sight of the form or its keywords changed since, rebuild its bitset
+        std::unique_lock lock(_mutex);
+        auto& entry = _entries[form];
+        if (entry.bits.size() != index.words || entry.keywords != form->keywords || entry.count != form->numKeywords) {
+            entry.keywords = form->keywords;
+            entry.count = form->numKeywords;
+            entry.bits.assign(index.words, 0);
+            for (std::uint32_t i = 0; i < form->numKeywords; ++i) {
+                if (auto it = index.bits.find(form->keywords[i]); it != index.bits.end()) {
+                    entry.bits[it->second / 64] |= 1ull << (it->second % 64);
+                }
+            }
+        }
+        return test(entry);
+    }
+
+// ╔════════════════════════════════════╗
+// ║         STATIC MATCH CACHE         ║
+// ╚════════════════════════════════════╝
+
+    bool StaticMatchCache::IsCurrent(const Entry& entry, RE::TESObjectREFR* ref) {
+        return entry.base == ref->GetBaseObject() &&
+               entry.formFlags == ref->formFlags &&
+               entry.lockLevel == ref->GetLockLevel() &&
+               entry.locked == ref->IsLocked();
+    }
+
+    void StaticMatchCache::Stamp(Entry& entry, RE::TESObjectREFR* ref) {
+        entry.base = ref->GetBaseObject();
+        entry.formFlags = ref->formFlags;
+        entry.lockLevel = ref->GetLockLevel();
+        entry.locked = ref->IsLocked();
+    }
+
+    std::uint64_t StaticMatchCache::FormListStamp(const Filter& filter) {
+        if (filter.formLists.empty() && filter.formListsNot.empty()) return 0;
+
+        std::uint64_t hash = 1469598103934665603ull;
+        const auto mix = [&hash](std::uint64_t value) {
+            hash ^= value;
+            hash *= 1099511628211ull;
+        };
+        for (const auto* entries : { &filter.formLists, &filter.formListsNot }) {
+            for (const auto& entry : *entries) {
+                if (!entry.list) continue;
+                mix(reinterpret_cast<std::uintptr_t>(entry.list->forms.data()));
+                mix(entry.list->forms.size());
+                mix(entry.list->scriptAddedFormCount);
+            }
+        }
+        return hash | 1;																// never 0, so an unstamped result never matches
+    }
+
+    void StaticMatchCache::SetRules(const std::vector<Rule>& rules, std::span<const std::size_t> updateRules) {
+        std::lock_guard lock(_mutex);
+        _entries.clear();
+        _clock.clear();
+        _hand = 0;
+        _resultSlots.assign(rules.size(), kNoSlot);
+        _stampSlots.assign(rules.size(), kNoSlot);
+        _resultCount = 0;
+        _stampCount = 0;
+
+        for (auto ruleIdx : updateRules) {
+            if (ruleIdx >= rules.size() || _resultSlots[ruleIdx] != kNoSlot) continue;
+            _resultSlots[ruleIdx] = static_cast<std::uint32_t>(_resultCount++);
+
+            const auto& filter = rules[ruleIdx].filter;
+            if (!filter.formLists.empty() || !filter.formListsNot.empty()) {
+                _stampSlots[ruleIdx] = static_cast<std::uint32_t>(_stampCount++);
+            }
+        }
+    }
+
+    StaticMatchCache::Result StaticMatchCache::Get(RE::TESObjectREFR* ref, std::size_t ruleIdx, std::uint64_t listStamp) {
+        if (ruleIdx >= _resultSlots.size() || _resultSlots[ruleIdx] == kNoSlot) return kUnknown;
+
+        std::lock_guard lock(_mutex);
+        auto it = _entries.find(ref->GetFormID());
+        if (it == _entries.end()) return kUnknown;
+
+        // The reference changed since its results were computed, drop them all
+        if (!IsCurrent(it->second, ref)) {
+            _entries.erase(it);
+            return kUnknown;
+        }
+
+        // A formlist of the rule changed, only this rule's result is stale
+        const auto stampSlot = _stampSlots[ruleIdx];
+        if (stampSlot != kNoSlot && it->second.listStamps[stampSlot] != listStamp) return kUnknown;
+        it->second.referenced = true;
+        return it->second.results[_resultSlots[ruleIdx]];
+    }
+
+    // Clock sweep: recently read references get a second chance, the first unread one is dropped
+    void StaticMatchCache::EvictOne() {
+        while (true) {
+            if (_hand >= _clock.size()) _hand = 0;
+            auto it = _entries.find(_clock[_hand]);
+            if (it == _entries.end()) return;											// forgotten on detach, the slot is free
+            if (it->second.referenced) {
+                it->second.referenced = false;
+                ++_hand;
+                continue;
+            }
+            _entries.erase(it);
+            return;
+        }
+    }
+
+    void StaticMatchCache::Set(RE::TESObjectREFR* ref, std::size_t ruleIdx, std::uint64_t listStamp, bool passed) {
+        if (ruleIdx >= _resultSlots.size() || _resultSlots[ruleIdx] == kNoSlot) return;
+
+        std::lock_guard lock(_mutex);
+
+        const RE::FormID refID = ref->GetFormID();
+        if (!_entries.contains(refID)) {
+            if (_clock.size() < kMaxEntries) {
+                _clock.push_back(refID);
+            } else {
+                EvictOne();
+                _clock[_hand++] = refID;
+            }
+        }
+
+        auto [it, inserted] = _entries.try_emplace(refID);
+        auto& entry = it->second;
+        if (inserted || !IsCurrent(entry, ref)) {
+            Stamp(entry, ref);
+            entry.results.assign(_resultCount, kUnknown);
+            entry.listStamps.assign(_stampCount, 0);
+        }
+        entry.results[_resultSlots[ruleIdx]] = passed ? kPass : kFail;
+        if (const auto stampSlot = _stampSlots[ruleIdx]; stampSlot != kNoSlot) {
+            entry.listStamps[stampSlot] = listStamp;
+        }
+    }
+
+    void StaticMatchCache::Forget(RE::FormID refID) {
+        std::lock_guard lock(_mutex);
+        _entries.erase(refID);
+    }
+
+    void RuleManager::ForgetStaticMatches(RE::FormID refID) {
+        if (auto ruleSet = GetRuleSet(); ruleSet && ruleSet->staticMatches) {
+            ruleSet->staticMatches->Forget(refID);
+        }
+    }
+
+// ╔════════════════════════════════════╗
+// ║         LOCATION ANCESTRY          ║
+// ╚════════════════════════════════════╝
+
+    std::shared_ptr<const LocationAncestry> RuleManager::BuildLocationAncestry(const std::shared_ptr<const LocationAncestry>& previous) {
+        auto* dataHandler = RE::TESDataHandler::GetSingleton();
+        if (!dataHandler) return previous;
+
+        const auto& locations = dataHandler->GetFormArray<RE::BGSLocation>();
+
+        // Location records do not change after data load, rebuild only if the loaded set differs
+        if (previous && previous->sourceCount == locations.size()) return previous;
+
+        auto ancestry = std::make_shared<LocationAncestry>();
+        ancestry->sourceCount = locations.size();
+        ancestry->denseIndex.reserve(locations.size());
+        ancestry->offsets.reserve(locations.size() + 1);
+
+        std::vector<RE::FormID> chain;
+        for (auto* location : locations) {
+            if (!location) continue;
+
+            auto [it, inserted] = ancestry->denseIndex.try_emplace(location->GetFormID(), static_cast<std::uint32_t>(ancestry->offsets.size()));
+            if (!inserted) continue;
+
+            ancestry->offsets.push_back(static_cast<std::uint32_t>(ancestry->ancestors.size()));
+
+            chain.clear();
+            chain.push_back(location->GetFormID());
+            for (auto* parentLoc = location->parentLoc; parentLoc; parentLoc = parentLoc->parentLoc) {
+                if (std::find(chain.begin(), chain.end(), parentLoc->GetFormID()) != chain.end()) {
+                    logger::warn("Circular reference detected in location hierarchy of {:08X}", location->GetFormID());
+                    break;
+                }
+                chain.push_back(parentLoc->GetFormID());
+            }
+
+            ancestry->ancestors.insert(ancestry->ancestors.end(), chain.begin(), chain.end());
+        }
+        ancestry->offsets.push_back(static_cast<std::uint32_t>(ancestry->ancestors.size()));
+
+        logger::info("Location ancestry built: {} locations, {} entries", ancestry->denseIndex.size(), ancestry->ancestors.size());
+        return ancestry;
+    }
+
+// ╔════════════════════════════════════╗
+// ║            EVENT INDEX             ║
+// ╚════════════════════════════════════╝
+
+    void RuleManager::BuildEventIndex(RuleSet& ruleSet) {
+        const auto& rules = ruleSet.rules;
+        for (auto& index : ruleSet.eventRules) {
+            index.Clear();
+        }
+
+        auto addUnique = [](std::vector<std::size_t>& bucket, std::size_t ruleIdx) {
+            if (bucket.empty() || bucket.back() != ruleIdx) {
+                bucket.push_back(ruleIdx);
+            }
+        };
+
+        for (std::size_t ruleIdx = 0; ruleIdx < rules.size(); ++ruleIdx) {
+            const auto& r = rules[ruleIdx];
+            const auto& f = r.filter;
+
+            for (auto ev : r.events) {
+                auto evIdx = static_cast<std::size_t>(ev);
+                if (evIdx >= kEventTypeCount) continue;
+
+                // A rule may list the same event twice, keep it only once per bucket
+                auto& index = ruleSet.eventRules[evIdx];
+                if (!index.rules.empty() && index.rules.back() == ruleIdx) continue;
+                index.rules.push_back(ruleIdx);
+
+                // Object identifiers are OR-ed in MatchFilter, so the rule is a candidate if any of them can match
+                bool hasObjectIdentifiers = false;
+                for (auto formID : f.formIDs) {
+                    addUnique(index.byFormID[formID], ruleIdx);
+                    hasObjectIdentifiers = true;
+                }
+                for (auto formType : f.formTypes) {
+                    addUnique(index.byFormType[formType], ruleIdx);
+                    hasObjectIdentifiers = true;
+                }
+                for (auto* kw : f.keywords) {
+                    if (!kw) continue;
+                    addUnique(index.byKeyword[kw], ruleIdx);
+                    hasObjectIdentifiers = true;
+                }
+                if (!f.formLists.empty()) {
+                    index.byFormList.push_back(ruleIdx);
+                    hasObjectIdentifiers = true;
+                }
+                if (!hasObjectIdentifiers) {
+                    index.wildcard.push_back(ruleIdx);
+                }
+            }
+        }
+
+        for (std::size_t evIdx = 0; evIdx < kEventTypeCount; ++evIdx) {
+            const auto& index = ruleSet.eventRules[evIdx];
+            if (!index.rules.empty()) {
+                logger::debug("Event {}: {} rule(s) registered ({} formIDs, {} formTypes, {} keywords, {} formlist rules, {} wildcard rules)",
+                    evIdx, index.rules.size(), index.byFormID.size(), index.byFormType.size(), index.byKeyword.size(), index.byFormList.size(), index.wildcard.size());
+            }
+        }
+    }
+
+    void RuleManager::CollectCandidateRules(const EventRuleIndex& index, RE::TESForm* baseObj, std::vector<std::size_t>& out) const {
+        out.clear();
+        if (index.rules.empty() || !baseObj) return;
+
+        auto append = [&out](const std::vector<std::size_t>& bucket) {
+            out.insert(out.end(), bucket.begin(), bucket.end());
+        };
 
-// ╔════════════════════════════════════╗
-// ║             SINGLETON              ║
-// ╚════════════════════════════════════╝
+        if (auto it = index.byFormID.find(baseObj->GetFormID()); it != index.byFormID.end()) {
+            append(it->second);
+        }
+        if (auto it = index.byFormType.find(baseObj->GetFormType()); it != index.byFormType.end()) {
+            append(it->second);
+        }
+        if (!index.byKeyword.empty()) {
+            if (auto* kwf = baseObj->As<RE::BGSKeywordForm>()) {
+                for (std::uint32_t i = 0; i < kwf->numKeywords; ++i) {
+                    if (auto it = index.byKeyword.find(kwf->keywords[i]); it != index.byKeyword.end()) {
+                        append(it->second);
+                    }
+                }
+            }
+        }
+        append(index.byFormList);
+        append(index.wildcard);
 
-    RuleManager* RuleManager::GetSingleton() {
-        static RuleManager inst;
-        return &inst;
+        // Keep the original rule order, a rule can be reached through several buckets
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
     }
 
-// ╔════════════════════════════════════╗
-// ║           LOADING RULES            ║
-// ╚════════════════════════════════════╝
+    EventPrefilter RuleManager::BuildPrefilter(const RuleSet& ruleSet, EventType event) {
+        EventPrefilter filter;
+        const auto& index = ruleSet.eventRules[static_cast<std::size_t>(event)];
 
-    void RuleManager::LoadRules() {
+        // A rule without object identifiers can match any reference
+        filter.matchAll = !index.wildcard.empty();
+        if (filter.matchAll) return filter;
 
-        std::unique_lock lock(_ruleMutex);
-        _rules.clear();
-        
-        const fs::path dir{ "Data/SKSE/Plugins/ObjectImpactFramework" };
-        if (!fs::exists(dir)) {
-            logger::error("Rules directory does not exist: {}", dir.string());
-            return;
-        }
+        for (auto ruleIdx : index.rules) {
+            const auto& rule = ruleSet.rules[ruleIdx];
 
-        try {
-            for (auto const& entry : fs::recursive_directory_iterator{ dir }) {
-                if (entry.is_regular_file() && entry.path().extension() == ".json") {
-                    ParseJSON(entry.path());
+            for (auto formType : rule.filter.formTypes) {
+                filter.formTypes.insert(formType);
+            }
+
+            for (auto formID : rule.filter.formIDs) {
+                filter.formIDs.insert(formID);
+            }
+
+            // Lists are matched through the membership cache so forms added later are still found
+            for (const auto& entry : rule.filter.formLists) {
+                if (entry.list && std::find(filter.formLists.begin(), filter.formLists.end(), entry.list) == filter.formLists.end()) {
+                    filter.formLists.push_back(entry.list);
                 }
             }
-        } catch (const fs::filesystem_error& e) {
-            logger::error("Filesystem error while loading rules: {}", e.what());
+
+            // Keywords are checked on the base object itself, so every keyword-capable form type can pass
+            for (auto* keyword : rule.filter.keywords) {
+                if (keyword) filter.keywords.insert(keyword);
+            }
         }
 
-        InvalidateUpdateCache();
+        return filter;
+    }
+
+    void RuleManager::LogEventStatistics() const {
+        for (std::size_t evIdx = 0; evIdx < kEventTypeCount; ++evIdx) {
+            auto triggers = _eventTriggerCounts[evIdx].load(std::memory_order_relaxed);
+            if (triggers == 0) continue;
 
-        logger::info("Total rules loaded: {}", _rules.size());
+            auto visited = _eventVisitedRuleCounts[evIdx].load(std::memory_order_relaxed);
+            logger::debug("Event {}: {} trigger(s), {} rule(s) visited", evIdx, triggers, visited);
+        }
     }
 
 
@@ -727,7 +1562,16 @@ namespace OIF {
 //██║░░░░░██║░░██║██║░░██║██████╔╝███████╗  ██║░░░░░██║███████╗███████╗
 //╚═╝░░░░░╚═╝░░╚═╝╚═╝░░╚═╝╚═════╝░╚══════╝  ╚═╝░░░░░╚═╝╚══════╝╚══════╝
 
-	void RuleManager::ParseJSON(const fs::path& path) {
+    // FNV-1a, unlike std::hash it gives the same value on every run and build
+    static std::uint32_t HashIdentity(std::string_view text, std::uint32_t hash = 2166136261u) {
+        for (unsigned char ch : text) {
+            hash ^= ch;
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+	void RuleManager::ParseJSON(const fs::path& path, std::vector<Rule>& rules) {
         std::ifstream ifs(path);
         if (!ifs.is_open()) {
             logger::error("Failed to open JSON file: {}", path.string());
@@ -748,6 +1592,7 @@ namespace OIF {
         }
 
         json jLow = lower_keys(j);
+        const std::uint32_t fileHash = HashIdentity(tolower_str(path.generic_string()));
 
         for (auto const& jr : jLow) {
             Rule r;
@@ -1230,7 +2075,7 @@ namespace OIF {
                 if (jf.contains("weaponstypes") && jf["weaponstypes"].is_array()) {
                     for (auto const& wt : jf["weaponstypes"]) {
                         if (wt.is_string()) {
-                            r.filter.weaponsTypes.insert(MapWeaponTypeToString(tolower_str(wt.get<std::string>())));
+                            r.filter.weaponsTypes |= HitMask(MapStringToWeaponType(tolower_str(wt.get<std::string>())));
                         } else {
                             logger::warn("Invalid weapon type '{}' in weaponstypes filter of {}", wt.get<std::string>(), path.string());
                         }
@@ -1240,7 +2085,7 @@ namespace OIF {
                 if (jf.contains("weaponstypesnot") && jf["weaponstypesnot"].is_array()) {
                     for (auto const& wt : jf["weaponstypesnot"]) {
                         if (wt.is_string()) {
-                            r.filter.weaponsTypesNot.insert(MapWeaponTypeToString(tolower_str(wt.get<std::string>())));
+                            r.filter.weaponsTypesNot |= HitMask(MapStringToWeaponType(tolower_str(wt.get<std::string>())));
                         } else {
                             logger::warn("Invalid weapon type '{}' in weaponstypesnot filter of {}", wt.get<std::string>(), path.string());
                         }
@@ -1458,7 +2303,7 @@ namespace OIF {
                     if (jf.contains("attacks")) {
                         for (auto const& at : jf["attacks"]) {
                             if (at.is_string()) {
-                                r.filter.attackTypes.insert(MapAttackTypeToString(tolower_str(at.get<std::string>())));
+                                r.filter.attackTypes |= HitMask(MapStringToAttackType(tolower_str(at.get<std::string>())));
                             } else {
                                 logger::warn("Invalid attack type '{}' in attacks filter of {}", at.get<std::string>(), path.string());
                             }
@@ -1467,7 +2312,7 @@ namespace OIF {
                     if (jf.contains("attackstypes")) {
                         for (auto const& at : jf["attackstypes"]) {
                             if (at.is_string()) {
-                                r.filter.attackTypes.insert(MapAttackTypeToString(tolower_str(at.get<std::string>())));
+                                r.filter.attackTypes |= HitMask(MapStringToAttackType(tolower_str(at.get<std::string>())));
                             } else {
                                 logger::warn("Invalid attack type '{}' in attackstypes filter of {}", at.get<std::string>(), path.string());
                             }
@@ -1479,7 +2324,7 @@ namespace OIF {
                     if (jf.contains("attacksnot")) {
                         for (auto const& at : jf["attacksnot"]) {
                             if (at.is_string()) {
-                                r.filter.attackTypesNot.insert(MapAttackTypeToString(tolower_str(at.get<std::string>())));
+                                r.filter.attackTypesNot |= HitMask(MapStringToAttackType(tolower_str(at.get<std::string>())));
                             } else {
                                 logger::warn("Invalid attack type '{}' in attacksnot filter of {}", at.get<std::string>(), path.string());
                             }
@@ -1488,7 +2333,7 @@ namespace OIF {
                     if (jf.contains("attackstypesnot")) {
                         for (auto const& at : jf["attackstypesnot"]) {
                             if (at.is_string()) {
-                                r.filter.attackTypesNot.insert(MapAttackTypeToString(tolower_str(at.get<std::string>())));
+                                r.filter.attackTypesNot |= HitMask(MapStringToAttackType(tolower_str(at.get<std::string>())));
                             } else {
                                 logger::warn("Invalid attack type '{}' in attackstypesnot filter of {}", at.get<std::string>(), path.string());
                             }
@@ -1499,7 +2344,7 @@ namespace OIF {
                 if (jf.contains("deliverytypes") && jf["deliverytypes"].is_array()) {
                     for (auto const& dt : jf["deliverytypes"]) {
                         if (dt.is_string()) {
-                            r.filter.deliveryTypes.insert(MapDeliveryTypeToString(tolower_str(dt.get<std::string>())));
+                            r.filter.deliveryTypes |= HitMask(MapStringToDeliveryType(tolower_str(dt.get<std::string>())));
                         } else {
                             logger::warn("Invalid delivery type '{}' in deliverytypes filter of {}", dt.get<std::string>(), path.string());
                         }
@@ -1509,7 +2354,7 @@ namespace OIF {
                 if (jf.contains("deliverytypesnot") && jf["deliverytypesnot"].is_array()) {
                     for (auto const& dt : jf["deliverytypesnot"]) {
                         if (dt.is_string()) {
-                            r.filter.deliveryTypesNot.insert(MapDeliveryTypeToString(tolower_str(dt.get<std::string>())));
+                            r.filter.deliveryTypesNot |= HitMask(MapStringToDeliveryType(tolower_str(dt.get<std::string>())));
                         } else {
                             logger::warn("Invalid delivery type '{}' in deliverytypesnot filter of {}", dt.get<std::string>(), path.string());
                         }
@@ -1845,7 +2690,7 @@ namespace OIF {
                             
                             if (levelStr.length() >= 2) {
                                 if (levelStr.substr(0, 2) == ">=" || levelStr.substr(0, 2) == "<=" || levelStr.substr(0, 2) == "!=") {
-                                    condition.operator_type = levelStr.substr(0, 2);
+                                    condition.operator_type = MapStringToCompareOp(levelStr.substr(0, 2));
                                     try {
                                         condition.value = std::stoi(levelStr.substr(2));
                                         r.filter.level.push_back(condition);
@@ -1853,7 +2698,7 @@ namespace OIF {
                                         logger::warn("Invalid level value '{}' in levels filter of {}: {}", levelStr, path.string(), e.what());
                                     }
                                 } else if (levelStr[0] == '>' || levelStr[0] == '<' || levelStr[0] == '=') {
-                                    condition.operator_type = levelStr.substr(0, 1);
+                                    condition.operator_type = MapStringToCompareOp(levelStr.substr(0, 1));
                                     try {
                                         condition.value = std::stoi(levelStr.substr(1));
                                         r.filter.level.push_back(condition);
@@ -1883,7 +2728,7 @@ namespace OIF {
                             
                             if (levelStr.length() >= 2) {
                                 if (levelStr.substr(0, 2) == ">=" || levelStr.substr(0, 2) == "<=" || levelStr.substr(0, 2) == "!=") {
-                                    condition.operator_type = levelStr.substr(0, 2);
+                                    condition.operator_type = MapStringToCompareOp(levelStr.substr(0, 2));
                                     try {
                                         condition.value = std::stoi(levelStr.substr(2));
                                         r.filter.levelNot.push_back(condition);
@@ -1891,7 +2736,7 @@ namespace OIF {
                                         logger::warn("Invalid level value '{}' in levelsnot filter of {}: {}", levelStr, path.string(), e.what());
                                     }
                                 } else if (levelStr[0] == '>' || levelStr[0] == '<' || levelStr[0] == '=') {
-                                    condition.operator_type = levelStr.substr(0, 1);
+                                    condition.operator_type = MapStringToCompareOp(levelStr.substr(0, 1));
                                     try {
                                         condition.value = std::stoi(levelStr.substr(1));
                                         r.filter.levelNot.push_back(condition);
@@ -1916,8 +2761,11 @@ namespace OIF {
                             std::smatch matches;
                             
                             if (std::regex_match(avStr, matches, avRegex)) {
-                                condition.actorValue = tolower_str(matches[1].str());
-                                condition.operator_type = matches[2].str();
+                                condition.actorValue = GetActorValueFromString(matches[1].str());
+                                condition.operator_type = MapStringToCompareOp(matches[2].str());
+                                if (condition.actorValue == RE::ActorValue::kNone) {
+                                    logger::warn("Unknown actor value '{}' in actorvalues filter of {}", matches[1].str(), path.string());
+                                }
                                 try {
                                     condition.value = std::stof(matches[3].str());
                                     r.filter.actorValue.push_back(condition);
@@ -1941,8 +2789,11 @@ namespace OIF {
                             std::smatch matches;
                             
                             if (std::regex_match(avStr, matches, avRegex)) {
-                                condition.actorValue = tolower_str(matches[1].str());
-                                condition.operator_type = matches[2].str();
+                                condition.actorValue = GetActorValueFromString(matches[1].str());
+                                condition.operator_type = MapStringToCompareOp(matches[2].str());
+                                if (condition.actorValue == RE::ActorValue::kNone) {
+                                    logger::warn("Unknown actor value '{}' in actorvaluesnot filter of {}", matches[1].str(), path.string());
+                                }
                                 try {
                                     condition.value = std::stof(matches[3].str());
                                     r.filter.actorValueNot.push_back(condition);
@@ -2369,6 +3220,13 @@ namespace OIF {
 								logger::warn("Invalid matchFilterRecheck value in timer filter of {}: {}", path.string(), e.what());
 							}
 						}
+
+						if (timerObj.contains("clock") && timerObj["clock"].is_string()) {
+							std::string clock = tolower_str(timerObj["clock"].get<std::string>());
+							if (clock == "game") r.filter.timer.clock = TimerClock::kGameTime;
+							else if (clock == "real") r.filter.timer.clock = TimerClock::kRealTime;
+							else logger::warn("Unknown clock '{}' in timer filter of {}, using real time", clock, path.string());
+						}
 					}
 				}
 
@@ -2387,8 +3245,11 @@ namespace OIF {
                             
                             if (std::regex_match(timeStr, matches, timeRegex)) {
                                 TimeCondition condition;
-                                condition.field = tolower_str(matches[1].str());
-                                condition.operator_type = matches[2].str();
+                                condition.field = MapStringToTimeField(tolower_str(matches[1].str()));
+                                condition.operator_type = MapStringToCompareOp(matches[2].str());
+                                if (condition.field == TimeField::kNone) {
+                                    logger::warn("Unknown time field '{}' in time filter of {}", matches[1].str(), path.string());
+                                }
                                 try {
                                     condition.value = std::stof(matches[3].str());
                                     r.filter.time.push_back(condition);
@@ -2417,8 +3278,11 @@ namespace OIF {
                             
                             if (std::regex_match(timeStr, matches, timeRegex)) {
                                 TimeCondition condition;
-                                condition.field = tolower_str(matches[1].str());
-                                condition.operator_type = matches[2].str();
+                                condition.field = MapStringToTimeField(tolower_str(matches[1].str()));
+                                condition.operator_type = MapStringToCompareOp(matches[2].str());
+                                if (condition.field == TimeField::kNone) {
+                                    logger::warn("Unknown time field '{}' in timenot filter of {}", matches[1].str(), path.string());
+                                }
                                 try {
                                     condition.value = std::stof(matches[3].str());
                                     r.filter.timeNot.push_back(condition);
@@ -2779,6 +3643,13 @@ namespace OIF {
 											logger::warn("Invalid matchFilterRecheck value in timer of items in {}: {}", path.string(), e.what());
 										}
 									}
+
+									if (timerObj.contains("clock") && timerObj["clock"].is_string()) {
+										std::string clock = tolower_str(timerObj["clock"].get<std::string>());
+										if (clock == "game") extData.timer.clock = TimerClock::kGameTime;
+										else if (clock == "real") extData.timer.clock = TimerClock::kRealTime;
+										else logger::warn("Unknown clock '{}' in timer of items in {}, using real time", clock, path.string());
+									}
 								}
 							}
 
@@ -2886,8 +3757,11 @@ namespace OIF {
                 continue;
             }
 
+            // Keys are sorted and lowercased, so formatting and key order do not change the identity
+            r.stableID = HashIdentity(jr.dump(), fileHash);
+
             try {
-                _rules.push_back(std::move(r));
+                rules.push_back(std::move(r));
             } catch (const std::exception& e) {
                 logger::error("Failed to add rule from {}: {}", path.string(), e.what());
                 continue;
@@ -2896,6 +3770,342 @@ namespace OIF {
     }
 
 
+// ╔════════════════════════════════════╗
+// ║          FILTER COMPILING          ║
+// ╚════════════════════════════════════╝
+
+    // Rough relative cost of each predicate, identity and enum checks first, spatial queries last
+    static std::uint32_t GetPredicateCost(FilterPredicate predicate) {
+        switch (predicate) {
+            case FilterPredicate::kFormTypesNot:
+            case FilterPredicate::kFormIDsNot:
+            case FilterPredicate::kDestructionStage:
+            case FilterPredicate::kAllowProjectiles:
+            case FilterPredicate::kWeaponsTypes:
+            case FilterPredicate::kWeaponsTypesNot:
+            case FilterPredicate::kAttackTypes:
+            case FilterPredicate::kAttackTypesNot:
+            case FilterPredicate::kDeliveryTypes:
+            case FilterPredicate::kDeliveryTypesNot:
+                return 1;
+
+            case FilterPredicate::kObjectIdentifiers:
+            case FilterPredicate::kWeapons:
+            case FilterPredicate::kWeaponsNot:
+            case FilterPredicate::kProjectiles:
+            case FilterPredicate::kProjectilesNot:
+            case FilterPredicate::kIsStacked:
+            case FilterPredicate::kIsInitiallyDisabled:
+            case FilterPredicate::kIsInterior:
+                return 2;
+
+            case FilterPredicate::kKeywordsNot:
+            case FilterPredicate::kWeaponsKeywords:
+            case FilterPredicate::kWeaponsKeywordsNot:
+            case FilterPredicate::kLockLevel:
+            case FilterPredicate::kLockLevelNot:
+            case FilterPredicate::kQuestItemStatus:
+                return 3;
+
+            case FilterPredicate::kIsSneaking:
+            case FilterPredicate::kIsSwimming:
+            case FilterPredicate::kIsInCombat:
+            case FilterPredicate::kIsMounted:
+            case FilterPredicate::kIsSprinting:
+            case FilterPredicate::kIsWeaponDrawn:
+            case FilterPredicate::kIsDualCasting:
+            case FilterPredicate::kActorRaces:
+            case FilterPredicate::kActorRacesNot:
+            case FilterPredicate::kLevel:
+            case FilterPredicate::kLevelNot:
+            case FilterPredicate::kIsFirstPerson:
+            case FilterPredicate::kIsThirdPerson:
+                return 4;
+
+            case FilterPredicate::kActorKeywords:
+            case FilterPredicate::kActorKeywordsNot:
+            case FilterPredicate::kFormListsNot:
+            case FilterPredicate::kWeather:
+            case FilterPredicate::kTime:
+                return 5;
+
+            case FilterPredicate::kActorValue:
+            case FilterPredicate::kActorValueNot:
+            case FilterPredicate::kPerks:
+            case FilterPredicate::kPerksNot:
+            case FilterPredicate::kSpells:
+            case FilterPredicate::kSpellsNot:
+            case FilterPredicate::kPosition:
+                return 6;
+
+            case FilterPredicate::kLocation:
+                return 7;
+
+            case FilterPredicate::kHasItem:
+            case FilterPredicate::kHasItemNot:
+                return 10;
+
+            case FilterPredicate::kNearby:
+            case FilterPredicate::kNearbyNot:
+                return 20;
+
+            default:
+                return 5;
+        }
+    }
+
+    void RuleManager::ResolveFilterForms(Rule& rule, std::vector<RE::FormID>& unresolved) {
+        auto& f = rule.filter;
+
+        // FormID sets stay the source of truth for which predicates a rule has, the arrays only hold what exists
+        auto resolve = [&unresolved]<class T>(const std::unordered_set<RE::FormID>& ids, std::vector<T*>& out) {
+            out.clear();
+            out.reserve(ids.size());
+            for (auto id : ids) {
+                if (auto* form = RE::TESForm::LookupByID<T>(id)) {
+                    out.push_back(form);
+                } else {
+                    unresolved.push_back(id);
+                }
+            }
+        };
+
+        resolve(f.perks, f.perkForms);
+        resolve(f.perksNot, f.perkFormsNot);
+        resolve(f.spells, f.spellForms);
+        resolve(f.spellsNot, f.spellFormsNot);
+        resolve(f.hasItem, f.hasItemForms);
+        resolve(f.hasItemNot, f.hasItemFormsNot);
+
+        for (auto* entries : { &f.formLists, &f.formListsNot }) {
+            for (auto& entry : *entries) {
+                entry.list = RE::TESForm::LookupByID<RE::BGSListForm>(entry.formID);
+                if (!entry.list) unresolved.push_back(entry.formID);
+            }
+        }
+    }
+
+    CompiledFilter RuleManager::CompileFilter(const Rule& rule) {
+        const auto& f = rule.filter;
+        CompiledFilter compiled;
+        auto& p = compiled.predicates;
+
+        if (!f.formTypes.empty() || !f.formIDs.empty() || !f.formLists.empty() || !f.keywords.empty()) p.push_back(FilterPredicate::kObjectIdentifiers);
+        if (!f.formTypesNot.empty()) p.push_back(FilterPredicate::kFormTypesNot);
+        if (!f.formIDsNot.empty()) p.push_back(FilterPredicate::kFormIDsNot);
+        if (!f.formListsNot.empty()) p.push_back(FilterPredicate::kFormListsNot);
+        if (!f.keywordsNot.empty()) p.push_back(FilterPredicate::kKeywordsNot);
+        if (f.questItemStatus != 3) p.push_back(FilterPredicate::kQuestItemStatus);
+        if (f.lockLevel != -2) p.push_back(FilterPredicate::kLockLevel);
+        if (f.lockLevelNot != -2) p.push_back(FilterPredicate::kLockLevelNot);
+        if (f.isStacked != 2) p.push_back(FilterPredicate::kIsStacked);
+        if (f.isInterior != 2) p.push_back(FilterPredicate::kIsInterior);
+        if (f.isInitiallyDisabled != 2) p.push_back(FilterPredicate::kIsInitiallyDisabled);
+        if (!f.time.empty() || !f.timeNot.empty()) p.push_back(FilterPredicate::kTime);
+        if (!f.locations.empty() || !f.locationsNot.empty()) p.push_back(FilterPredicate::kLocation);
+        if (!f.weathers.empty() || !f.weathersNot.empty()) p.push_back(FilterPredicate::kWeather);
+        if (f.position != 3) p.push_back(FilterPredicate::kPosition);
+        if (f.isFirstPerson != 2) p.push_back(FilterPredicate::kIsFirstPerson);
+        if (f.isThirdPerson != 2) p.push_back(FilterPredicate::kIsThirdPerson);
+        if (!f.perks.empty()) p.push_back(FilterPredicate::kPerks);
+        if (!f.perksNot.empty()) p.push_back(FilterPredicate::kPerksNot);
+        if (!f.spells.empty()) p.push_back(FilterPredicate::kSpells);
+        if (!f.spellsNot.empty()) p.push_back(FilterPredicate::kSpellsNot);
+        if (!f.hasItem.empty()) p.push_back(FilterPredicate::kHasItem);
+        if (!f.hasItemNot.empty()) p.push_back(FilterPredicate::kHasItemNot);
+        if (!f.level.empty()) p.push_back(FilterPredicate::kLevel);
+        if (!f.levelNot.empty()) p.push_back(FilterPredicate::kLevelNot);
+        if (!f.actorValue.empty()) p.push_back(FilterPredicate::kActorValue);
+        if (!f.actorValueNot.empty()) p.push_back(FilterPredicate::kActorValueNot);
+        if (!f.actorKeywords.empty()) p.push_back(FilterPredicate::kActorKeywords);
+        if (!f.actorKeywordsNot.empty()) p.push_back(FilterPredicate::kActorKeywordsNot);
+        if (!f.actorRaces.empty()) p.push_back(FilterPredicate::kActorRaces);
+        if (!f.actorRacesNot.empty()) p.push_back(FilterPredicate::kActorRacesNot);
+        if (f.isSneaking != 2) p.push_back(FilterPredicate::kIsSneaking);
+        if (f.isSwimming != 2) p.push_back(FilterPredicate::kIsSwimming);
+        if (f.isInCombat != 2) p.push_back(FilterPredicate::kIsInCombat);
+        if (f.isMounted != 2) p.push_back(FilterPredicate::kIsMounted);
+        if (f.isSprinting != 2) p.push_back(FilterPredicate::kIsSprinting);
+        if (f.isWeaponDrawn != 2) p.push_back(FilterPredicate::kIsWeaponDrawn);
+        if (f.destructionStage != -1) p.push_back(FilterPredicate::kDestructionStage);
+        if (f.allowProjectiles != 1) p.push_back(FilterPredicate::kAllowProjectiles);
+        if (f.weaponsTypes) p.push_back(FilterPredicate::kWeaponsTypes);
+        if (f.weaponsTypesNot) p.push_back(FilterPredicate::kWeaponsTypesNot);
+        if (!f.weapons.empty()) p.push_back(FilterPredicate::kWeapons);
+        if (!f.weaponsNot.empty()) p.push_back(FilterPredicate::kWeaponsNot);
+        if (!f.weaponsKeywords.empty()) p.push_back(FilterPredicate::kWeaponsKeywords);
+        if (!f.weaponsKeywordsNot.empty()) p.push_back(FilterPredicate::kWeaponsKeywordsNot);
+        if (!f.projectiles.empty()) p.push_back(FilterPredicate::kProjectiles);
+        if (!f.projectilesNot.empty()) p.push_back(FilterPredicate::kProjectilesNot);
+        if (f.attackTypes) p.push_back(FilterPredicate::kAttackTypes);
+        if (f.attackTypesNot) p.push_back(FilterPredicate::kAttackTypesNot);
+        if (f.deliveryTypes) p.push_back(FilterPredicate::kDeliveryTypes);
+        if (f.deliveryTypesNot) p.push_back(FilterPredicate::kDeliveryTypesNot);
+        if (f.isDualCasting != 2) p.push_back(FilterPredicate::kIsDualCasting);
+        if (!f.nearby.empty()) p.push_back(FilterPredicate::kNearby);
+        if (!f.nearbyNot.empty()) p.push_back(FilterPredicate::kNearbyNot);
+
+        // Predicates are independent, so any order gives the same result; ties keep declaration order
+        std::stable_sort(p.begin(), p.end(), [](FilterPredicate a, FilterPredicate b) {
+            return GetPredicateCost(a) < GetPredicateCost(b);
+        });
+
+        compiled.hasDynamicFormList = std::any_of(f.formLists.begin(), f.formLists.end(),
+            [](const FormListEntry& entry) { return entry.index == -2; });
+
+        // Limits, interactions and timers consume state before the chance roll, those rules keep the roll at the end
+        compiled.earlyChance = f.limit.value == 0 && !f.limit.useRandom &&
+                               f.interactions.value <= 1 && !f.interactions.useRandom &&
+                               f.timer.time.value <= 0.0f;
+
+        return compiled;
+    }
+
+    void RuleManager::InitAdaptiveOrders(RuleSet& ruleSet) {
+        ruleSet.adaptiveOrders = std::make_unique<AdaptiveFilterOrder[]>(ruleSet.rules.size());
+
+        for (std::size_t ruleIdx = 0; ruleIdx < ruleSet.rules.size(); ++ruleIdx) {
+            auto& adaptive = ruleSet.adaptiveOrders[ruleIdx];
+            auto count = ruleSet.rules[ruleIdx].compiled.predicates.size();
+
+            // Start from the load-time cost order
+            adaptive.orders = std::make_unique<std::uint8_t[]>(count * 2);
+            std::iota(adaptive.orders.get(), adaptive.orders.get() + count, static_cast<std::uint8_t>(0));
+
+            adaptive.stats = std::make_unique<PredicateStats[]>(count);
+            adaptive.order = adaptive.orders.get();
+        }
+    }
+
+    void RuleManager::BuildKeywordMasks(RuleSet& ruleSet) {
+        auto& index = ruleSet.keywordIndex;
+        for (const auto& rule : ruleSet.rules) {
+            const auto& f = rule.filter;
+            index.Add(f.keywords);
+            index.Add(f.keywordsNot);
+            index.Add(f.weaponsKeywords);
+            index.Add(f.weaponsKeywordsNot);
+            index.Add(f.actorKeywords);
+            index.Add(f.actorKeywordsNot);
+        }
+
+        for (auto& rule : ruleSet.rules) {
+            const auto& f = rule.filter;
+            auto& compiled = rule.compiled;
+            compiled.keywords = index.MakeMask(f.keywords);
+            compiled.keywordsNot = index.MakeMask(f.keywordsNot);
+            compiled.weaponsKeywords = index.MakeMask(f.weaponsKeywords);
+            compiled.weaponsKeywordsNot = index.MakeMask(f.weaponsKeywordsNot);
+            compiled.actorKeywords = index.MakeMask(f.actorKeywords);
+            compiled.actorKeywordsNot = index.MakeMask(f.actorKeywordsNot);
+        }
+
+        ruleSet.keywordCache = std::make_unique<KeywordSetCache>();
+        ruleSet.staticMatches = std::make_unique<StaticMatchCache>();
+        logger::info("Keyword index built: {} keywords in {} words", index.bits.size(), index.words);
+    }
+
+// ╔════════════════════════════════════╗
+// ║      ADAPTIVE PREDICATE ORDER      ║
+// ╚════════════════════════════════════╝
+
+    void RuleManager::UpdatePredicateOrder() {
+        auto* settings = Settings::GetSingleton();
+        if (settings->freezePredicateOrder) return;
+
+        static auto lastReorderTime = std::chrono::steady_clock::now();
+        auto now = std::chrono::steady_clock::now();
+        if (std::chrono::duration<float>(now - lastReorderTime).count() < settings->predicateReorderInterval) return;
+        lastReorderTime = now;
+
+        auto ruleSet = GetRuleSet();
+        if (!ruleSet || !ruleSet->adaptiveOrders) return;
+
+        std::lock_guard lock(_reorderMutex);
+
+        constexpr double kStaticCostNs = 10.0;			// nanoseconds per static cost unit for predicates without timing samples
+        constexpr std::uint64_t kMinCostSamples = 8;
+        constexpr double kMinGain = 0.1;				// a new order has to cut the expected cost by 10%, keeps near ties from flipping back and forth
+
+        std::size_t reordered = 0;
+        std::vector<double> costs;
+        std::vector<double> rejectRates;
+        std::vector<double> scores;
+        std::vector<std::uint8_t> newOrder;
+
+        // Predicates are independent conjuncts, each one only runs if every earlier one passed
+        auto expectedCost = [&costs, &rejectRates](std::span<const std::uint8_t> order) {
+            double total = 0.0;
+            double reached = 1.0;
+            for (auto slot : order) {
+                total += reached * costs[slot];
+                reached *= 1.0 - rejectRates[slot];
+            }
+            return total;
+        };
+
+        // Halving the counters after every pass lets recent behaviour outweigh old samples
+        auto decay = [](std::uint64_t& counter) { counter /= 2; };
+
+        for (std::size_t ruleIdx = 0; ruleIdx < ruleSet->rules.size(); ++ruleIdx) {
+            const auto& predicates = ruleSet->rules[ruleIdx].compiled.predicates;
+            auto& adaptive = ruleSet->adaptiveOrders[ruleIdx];
+
+            if (predicates.size() < 2) continue;
+            if (adaptive.evaluations < settings->predicateReorderMinSamples) continue;
+
+            // Running the predicates by ascending cost / rejection rate minimizes the expected cost
+            costs.assign(predicates.size(), 0.0);
+            rejectRates.assign(predicates.size(), 0.0);
+            scores.assign(predicates.size(), 0.0);
+            for (std::size_t slot = 0; slot < predicates.size(); ++slot) {
+                const auto& stats = adaptive.stats[slot];
+                auto evaluated = stats.evaluated;
+                auto rejected = stats.rejected;
+                auto sampled = stats.sampled;
+
+                double cost = sampled >= kMinCostSamples ?
+                    static_cast<double>(stats.sampledCost) / static_cast<double>(sampled) :
+                    static_cast<double>(GetPredicateCost(predicates[slot])) * kStaticCostNs;
+
+                // Laplace smoothing gives rarely reached predicates a neutral rejection estimate
+                double rejectRate = (static_cast<double>(rejected) + 1.0) / (static_cast<double>(evaluated) + 2.0);
+                costs[slot] = cost;
+                rejectRates[slot] = rejectRate;
+                scores[slot] = cost / rejectRate;
+
+                decay(stats.evaluated);
+                decay(stats.rejected);
+                decay(stats.sampledCost);
+                decay(stats.sampled);
+            }
+            decay(adaptive.evaluations);
+
+            newOrder.resize(predicates.size());
+            std::iota(newOrder.begin(), newOrder.end(), static_cast<std::uint8_t>(0));
+
+            // Ties fall back to the load-time slot order, which keeps the result deterministic
+            std::stable_sort(newOrder.begin(), newOrder.end(), [&scores](std::uint8_t a, std::uint8_t b) {
+                return scores[a] < scores[b];
+            });
+
+            const std::span<const std::uint8_t> currentOrder{ adaptive.order, predicates.size() };
+            if (std::ranges::equal(currentOrder, newOrder)) continue;
+            if (expectedCost(newOrder) > expectedCost(currentOrder) * (1.0 - kMinGain)) continue;
+
+            // MatchFilter runs on this thread too, so the order not in use is never being read
+            auto* spare = adaptive.order == adaptive.orders.get() ? adaptive.orders.get() + predicates.size() : adaptive.orders.get();
+            std::ranges::copy(newOrder, spare);
+            adaptive.order = spare;
+            ++reordered;
+        }
+
+        if (reordered > 0) {
+            logger::debug("Adaptive filter order updated for {} rule(s)", reordered);
+        }
+    }
+
+
 //███████╗██╗██╗░░░░░████████╗███████╗██████╗░  ███╗░░░███╗░█████╗░████████╗░█████╗░██╗░░██╗
 //██╔════╝██║██║░░░░░╚══██╔══╝██╔════╝██╔══██╗  ████╗░████║██╔══██╗╚══██╔══╝██╔══██╗██║░░██║
 //█████╗░░██║██║░░░░░░░░██║░░░█████╗░░██████╔╝  ██╔████╔██║███████║░░░██║░░░██║░░╚═╝███████║
@@ -2903,602 +4113,612 @@ namespace OIF {
 //██║░░░░░██║███████╗░░░██║░░░███████╗██║░░██║  ██║░╚═╝░██║██║░░██║░░░██║░░░╚█████╔╝██║░░██║
 //╚═╝░░░░░╚═╝╚══════╝░░░╚═╝░░░╚══════╝╚═╝░░╚═╝  ╚═╝░░░░░╚═╝╚═╝░░╚═╝░░░╚═╝░░░░╚════╝░╚═╝░░╚═╝
 
-    bool RuleManager::MatchFilter(const Filter& f, const RuleContext& ctx, Rule& currentRule) const {
-        if (!CheckTimeFilters(f)) return false;
+    bool RuleManager::MatchFilter(const Rule& rule, const RuleContext& ctx, RuleScratch& scratch) const {
 		if (!ctx.target || ctx.target->IsDeleted() || !ctx.target->GetBaseObject()) return false;
-		auto* baseObj = ctx.target->GetBaseObject();
-
-        if (!f.nearby.empty()) {
-			if (!ctx.target || ctx.target->IsDeleted() || !ctx.source) return false;
-			std::unordered_map<RE::FormID, float> nearbyMap;
-			float maxRadius = 0.0f;
-    
-			std::random_device rd;
-			std::mt19937 rng(rd());
-    
-			for (const auto& nearbyEntry : f.nearby) {
-				if (!nearbyEntry.form) continue;
-        
-				float actualRadius = nearbyEntry.radius.value;
-				if (nearbyEntry.radius.useRandom) {
-					actualRadius = std::uniform_real_distribution<float>(nearbyEntry.radius.min, nearbyEntry.radius.max)(rng);
-				}
-        
-				nearbyMap[nearbyEntry.form->GetFormID()] = actualRadius;
-				maxRadius = (std::max)(maxRadius, actualRadius);
-			}
-    
-			if (nearbyMap.empty()) return false;
-			auto* tes = RE::TES::GetSingleton();
-			if (!tes) return false;
-    
-			bool proximityConditionMet = false;
-			if (!ctx.target || ctx.target->IsDeleted() || !ctx.source) return false;
-			tes->ForEachReferenceInRange(ctx.target, maxRadius, [&](RE::TESObjectREFR* ref) -> RE::BSContainer::ForEachResult {
-				if (!ref || ref->IsDeleted()) return RE::BSContainer::ForEachResult::kContinue;
-        
-				auto* baseObj = ref->GetBaseObject();
-				if (!baseObj) return RE::BSContainer::ForEachResult::kContinue;
-                        
-				auto it = nearbyMap.find(baseObj->GetFormID());
-				if (it != nearbyMap.end()) {
-					if (!ctx.target || ctx.target->IsDeleted()) return RE::BSContainer::ForEachResult::kContinue;
-					auto targetPos = ctx.target->GetPosition();
-					float distance = targetPos.GetDistance(ref->GetPosition());
-					if (distance <= it->second) {
-						proximityConditionMet = true;
-						return RE::BSContainer::ForEachResult::kStop;
-					}
-				}
-        
-				return RE::BSContainer::ForEachResult::kContinue;
-			});
-        
-			if (!proximityConditionMet) return false;
-		}
 
-		if (!f.nearbyNot.empty()) {
-			if (!ctx.target || ctx.target->IsDeleted() || !ctx.source) return false;
-			std::unordered_map<RE::FormID, float> nearbyNotMap;
-			float maxRadius = 0.0f;
-    
-			std::random_device rd;
-			std::mt19937 rng(rd());
-    
-			for (const auto& nearbyEntry : f.nearbyNot) {
-				if (!nearbyEntry.form) continue;
-        
-				float actualRadius = nearbyEntry.radius.value;
-				if (nearbyEntry.radius.useRandom) {
-					actualRadius = std::uniform_real_distribution<float>(nearbyEntry.radius.min, nearbyEntry.radius.max)(rng);
-				}
-        
-				nearbyNotMap[nearbyEntry.form->GetFormID()] = actualRadius;
-				maxRadius = (std::max)(maxRadius, actualRadius);
-			}
-    
-			if (!nearbyNotMap.empty()) {
-				auto* tes = RE::TES::GetSingleton();
-				if (!tes) return false;
-				bool foundExcludedForm = false;
-				if (!ctx.target || ctx.target->IsDeleted() || !ctx.source) return false;
-				tes->ForEachReferenceInRange(ctx.target, maxRadius, [&](RE::TESObjectREFR* ref) -> RE::BSContainer::ForEachResult {
-					if (!ref || ref->IsDeleted()) return RE::BSContainer::ForEachResult::kContinue;
-            
-					auto* baseObj = ref->GetBaseObject();
-					if (!baseObj) return RE::BSContainer::ForEachResult::kContinue;
-                                
-					auto it = nearbyNotMap.find(baseObj->GetFormID());
-					if (it != nearbyNotMap.end()) {
-						if (!ctx.target || ctx.target->IsDeleted()) return RE::BSContainer::ForEachResult::kContinue;
-						auto targetPos = ctx.target->GetPosition();
-						float distance = targetPos.GetDistance(ref->GetPosition());
-						if (distance <= it->second) {
-							foundExcludedForm = true;
-							return RE::BSContainer::ForEachResult::kStop;
-						}
-					}
-            
-					return RE::BSContainer::ForEachResult::kContinue;
-				});
-            
-				if (foundExcludedForm) return false;
-			}
-		}
+        const auto& predicates = rule.compiled.predicates;
+        if (predicates.empty()) return true;
 
-        bool objectIdentifierMatch = false;
-        bool hasObjectIdentifiers = false;
+        // Index -2 formlists fill the dynamic index on every evaluation, so object identifiers stay dynamic for them
+        auto isStatic = [&rule](FilterPredicate predicate) {
+            return IsStaticPredicate(predicate) && !(predicate == FilterPredicate::kObjectIdentifiers && rule.compiled.hasDynamicFormList);
+        };
 
-        if (!f.formTypes.empty()) {
-            hasObjectIdentifiers = true;
-            if (f.formTypes.contains(baseObj->GetFormType())) {
-                objectIdentifierMatch = true;
+        // OnUpdate sweeps revisit the same references, predicates that only depend on the reference are evaluated once
+        auto* staticCache = ctx.event == EventType::kOnUpdate ? scratch.ruleSet->staticMatches.get() : nullptr;
+        if (staticCache) {
+            // Formlist predicates are static per reference, but the lists themselves can change at runtime
+            const auto listStamp = StaticMatchCache::FormListStamp(rule.filter);
+            auto cached = staticCache->Get(ctx.target, scratch.ruleIdx, listStamp);
+            if (cached == StaticMatchCache::kFail) return false;
+            if (cached == StaticMatchCache::kUnknown) {
+                bool staticPassed = true;
+                for (auto predicate : predicates) {
+                    if (isStatic(predicate) && !MatchPredicate(predicate, rule, ctx, scratch)) {
+                        staticPassed = false;
+                        break;
+                    }
+                }
+                staticCache->Set(ctx.target, scratch.ruleIdx, listStamp, staticPassed);
+                if (!staticPassed) return false;
             }
         }
-        if (!f.formTypesNot.empty() && f.formTypesNot.contains(baseObj->GetFormType())) return false;
-        if (!f.formIDs.empty()) {
-            hasObjectIdentifiers = true;
-			if (f.formIDs.contains(baseObj->GetFormID())) {
-                objectIdentifierMatch = true;
+
+        auto& adaptive = scratch.ruleSet->adaptiveOrders[scratch.ruleIdx];
+        const std::span<const std::uint8_t> order{ adaptive.order, predicates.size() };
+
+        // Time only one evaluation out of 16 to keep the clock reads off the common path
+        const bool sampleCost = (adaptive.evaluations++ & 15) == 0;
+
+        for (auto slot : order) {
+            auto predicate = predicates[slot];
+            if (!ctx.isHitEvent && IsHitPredicate(predicate)) continue;
+            if (staticCache && isStatic(predicate)) continue;
+
+            auto& stats = adaptive.stats[slot];
+            bool passed;
+            if (sampleCost) {
+                auto start = std::chrono::steady_clock::now();
+                passed = MatchPredicate(predicate, rule, ctx, scratch);
+                auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+                stats.sampledCost += static_cast<std::uint64_t>(elapsed);
+                ++stats.sampled;
+            } else {
+                passed = MatchPredicate(predicate, rule, ctx, scratch);
+            }
+
+            ++stats.evaluated;
+            if (!passed) {
+                ++stats.rejected;
+                return false;
             }
         }
-        if (!f.formIDsNot.empty() && f.formIDsNot.contains(baseObj->GetFormID())) return false;
-        if (!f.formLists.empty()) {
-            hasObjectIdentifiers = true;
-            bool matched = false;
-            for (const auto& entry : f.formLists) {
-                auto* list = RE::TESForm::LookupByID<RE::BGSListForm>(entry.formID);
-                if (!list) continue;
-
-                if (entry.index == -2) {
-                    // Find the object index in a formlist
-                    int foundIdx = -1;
-                    for (int i = 0; i < static_cast<int>(list->forms.size()); ++i) {
-                        if (list->forms[i] && list->forms[i]->GetFormID() == baseObj->GetFormID()) {
-                            foundIdx = i;
-                            break;
-                        }
-                    }
-                    if (foundIdx != -1) {
-                        // Save the current rule in dynamicIndex
-                        currentRule.dynamicIndex = foundIdx;
-                        matched = true;
+
+        return true;
+    }
+
+    bool RuleManager::MatchPredicate(FilterPredicate predicate, const Rule& rule, const RuleContext& ctx, RuleScratch& scratch) const {
+        const auto& f = rule.filter;
+		auto* baseObj = ctx.target->GetBaseObject();
+
+        switch (predicate) {
+            case FilterPredicate::kObjectIdentifiers:
+            {
+                // Object identifiers are OR-ed: the target has to match at least one of them
+                bool objectIdentifierMatch = f.formTypes.contains(baseObj->GetFormType()) || f.formIDs.contains(baseObj->GetFormID());
+
+                if (!objectIdentifierMatch && !f.keywords.empty()) {
+                    auto* kwf = baseObj->As<RE::BGSKeywordForm>();
+                    if (kwf && scratch.ruleSet->keywordCache->HasAny(scratch.ruleSet->keywordIndex, kwf, rule.compiled.keywords)) {
+                        objectIdentifierMatch = true;
                     }
-                } else if (entry.index >= 0) {
-                    // Check only one element in the list (according to the index)
-                    if (entry.index < static_cast<int>(list->forms.size())) {
-                        auto* el = list->forms[entry.index];
-                        if (el && el->GetFormID() == baseObj->GetFormID()) {
-                            matched = true;
-                            break;
+                }
+
+                // Formlists with index -2 are always scanned since they fill the dynamic index used by effects
+                if (!f.formLists.empty() && (!objectIdentifierMatch || rule.compiled.hasDynamicFormList)) {
+                    bool matched = false;
+                    auto* listCache = FormListCache::GetSingleton();
+                    for (const auto& entry : f.formLists) {
+                        auto* list = entry.list;
+                        if (!list) continue;
+
+                        if (entry.index == -2) {
+                            // Find the object index in a formlist
+                            int foundIdx = listCache->IndexOf(list, baseObj->GetFormID());
+                            if (foundIdx != -1) {
+                                // Save the current rule in dynamicIndex
+                                scratch.dynamicIndex = foundIdx;
+                                matched = true;
+                            }
+                        } else if (entry.index >= 0) {
+                            // Check only one element in the list (according to the index)
+                            if (entry.index < static_cast<int>(list->forms.size())) {
+                                auto* el = list->forms[entry.index];
+                                if (el && el->GetFormID() == baseObj->GetFormID()) {
+                                    matched = true;
+                                    break;
+                                }
+                            }
+                        } else {
+                            // Check all the elements of the list
+                            if (listCache->Contains(list, baseObj->GetFormID())) {
+                                matched = true;
+                            }
                         }
-                    }
-                } else {
-                    // Check all the elements of the list
-                    for (auto* el : list->forms) {
-                        if (el && el->GetFormID() == baseObj->GetFormID()) {
-                            matched = true;
+
+                        if (matched) {
+                            objectIdentifierMatch = true;
                             break;
                         }
                     }
                 }
 
-                if (matched) {
-                    objectIdentifierMatch = true;
-                    break;
-                }
+                return objectIdentifierMatch;
             }
-        }
-        if (!f.formListsNot.empty()) {
-            for (const auto& entry : f.formListsNot) {
-                auto* list = RE::TESForm::LookupByID<RE::BGSListForm>(entry.formID);
-                if (!list) continue;
-                // Check all the elements of the list
-                for (auto* el : list->forms) {
-                    if (el && el->GetFormID() == baseObj->GetFormID()) return false;
+
+            case FilterPredicate::kFormTypesNot:
+                return !f.formTypesNot.contains(baseObj->GetFormType());
+
+            case FilterPredicate::kFormIDsNot:
+                return !f.formIDsNot.contains(baseObj->GetFormID());
+
+            case FilterPredicate::kFormListsNot:
+            {
+                auto* listCache = FormListCache::GetSingleton();
+                for (const auto& entry : f.formListsNot) {
+                    auto* list = entry.list;
+                    if (!list) continue;
+                    // Check all the elements of the list
+                    if (listCache->Contains(list, baseObj->GetFormID())) return false;
                 }
+                return true;
             }
-        }
-        if (!f.keywords.empty()) {
-            hasObjectIdentifiers = true;
-            auto* kwf = baseObj->As<RE::BGSKeywordForm>();
-            if (kwf) {
-                for (auto* kw : f.keywords) {
-                    if (kw && kwf->HasKeyword(kw)) {
-                        objectIdentifierMatch = true;
-                        break;
+
+            case FilterPredicate::kKeywordsNot:
+            {
+                auto* kwf = baseObj->As<RE::BGSKeywordForm>();
+                return !kwf || !scratch.ruleSet->keywordCache->HasAny(scratch.ruleSet->keywordIndex, kwf, rule.compiled.keywordsNot);
+            }
+
+            case FilterPredicate::kQuestItemStatus:
+                return f.questItemStatus == GetQuestItemStatus(ctx.target);
+
+            case FilterPredicate::kLockLevel:
+            {
+                bool matched = false;
+                if (auto lockData = ctx.target->extraList.GetByType<RE::ExtraLock>()) {
+                    if (auto* lock = lockData->lock) {
+                        RE::LOCK_LEVEL lvl = lock->GetLockLevel(ctx.target);
+                        if (lvl == GetLockLevel(f.lockLevel)) {
+                            matched = true;
+                        }
                     }
+                } else if (f.lockLevel == -1) {
+                    matched = true;	 // No lock data means it's not locked
                 }
+                return matched;
             }
-        }
-        if (!f.keywordsNot.empty()) {
-            auto* kwf = baseObj->As<RE::BGSKeywordForm>();
-            if (kwf) {
-                for (auto* kw : f.keywordsNot) {
-                    if (kw && kwf->HasKeyword(kw)) return false;
+
+            case FilterPredicate::kLockLevelNot:
+            {
+                bool matched = false;
+                if (auto lockData = ctx.target->extraList.GetByType<RE::ExtraLock>()) {
+                    if (auto* lock = lockData->lock) {
+                        RE::LOCK_LEVEL lvl = lock->GetLockLevel(ctx.target);
+                        if (lvl == GetLockLevel(f.lockLevelNot)) {
+                            matched = true;
+                        }
+                    }
+                } else if (f.lockLevelNot == -1) {
+                    matched = true;
                 }
+                return !matched;
             }
-        }
-        if (f.questItemStatus != 3) {
-            auto currentStatus = GetQuestItemStatus(ctx.target);
-            
-            if (f.questItemStatus != currentStatus) {
-                return false;
+
+            case FilterPredicate::kIsStacked:
+            {
+                if (f.isStacked == 0 && ctx.target->extraList.GetCount() > 1) return false;
+                if (f.isStacked == 1 && ctx.target->extraList.GetCount() <= 1) return false;
+                return true;
             }
-        }
-		if (f.lockLevel != -2) {
-			bool matched = false;
-			if (auto lockData = ctx.target->extraList.GetByType<RE::ExtraLock>()) {
-				if (auto* lock = lockData->lock) {
-					RE::LOCK_LEVEL lvl = lock->GetLockLevel(ctx.target);
-					if (lvl == GetLockLevel(f.lockLevel)) {
-						matched = true;
-					}
-				}
-			} else if (f.lockLevel == -1) {
-				matched = true;	 // No lock data means it's not locked
-			}
-			if (!matched) return false;
-		}
-		if (f.lockLevelNot != -2) {
-			bool matched = false;
-			if (auto lockData = ctx.target->extraList.GetByType<RE::ExtraLock>()) {
-				if (auto* lock = lockData->lock) {
-					RE::LOCK_LEVEL lvl = lock->GetLockLevel(ctx.target);
-					if (lvl == GetLockLevel(f.lockLevelNot)) {
-						matched = true;
-					}
-				}
-			} else if (f.lockLevelNot == -1) {
-				matched = true;
-			}
-			if (matched) return false;
-		}
-		if (f.isStacked != 2) {
-			if (f.isStacked == 0 && ctx.target->extraList.GetCount() > 1) return false;
-			if (f.isStacked == 1 && ctx.target->extraList.GetCount() <= 1) return false;
-		}
-		if (f.isInterior != 2) {
-			auto* cell = ctx.target->GetParentCell();
-			if (!cell) return false;
-			bool interior = cell->IsInteriorCell();
-			if (f.isInterior == 0 && interior) return false;
-			if (f.isInterior == 1 && !interior) return false;
-		}
-		if (f.position != 3) {
-			auto player = RE::PlayerCharacter::GetSingleton();
-			if (!player) return false;
-
-			NiPoint3 targetCenter = { 0.0f, 0.0f, 0.0f };
-			NiPoint3 playerCenter = { 0.0f, 0.0f, 0.0f };
-
-			if (auto* root = ctx.target->Get3D()) {
-				targetCenter = root->worldBound.center;
-			} else {
-				const auto& bmin = ctx.target->GetBoundMin();
-				const auto& bmax = ctx.target->GetBoundMax();
-				targetCenter = {
-					(bmin.x + bmax.x) * 0.5f,
-					(bmin.y + bmax.y) * 0.5f,
-					(bmin.z + bmax.z) * 0.5f
-				};
-			}
 
-			if (auto* root = player->Get3D()) {
-				playerCenter = root->worldBound.center;
-			} else {
-				const auto& pmin = player->GetBoundMin();
-				const auto& pmax = player->GetBoundMax();
-				playerCenter = {
-					(pmin.x + pmax.x) * 0.5f,
-					(pmin.y + pmax.y) * 0.5f,
-					(pmin.z + pmax.z) * 0.5f
-				};
-			}
+            case FilterPredicate::kIsInterior:
+            {
+                auto* cell = ctx.target->GetParentCell();
+                if (!cell) return false;
+                bool interior = cell->IsInteriorCell();
+                if (f.isInterior == 0 && interior) return false;
+                if (f.isInterior == 1 && !interior) return false;
+                return true;
+            }
 
-			uint32_t actualPosition;
-			if (targetCenter.z < playerCenter.z - 30.0f) {
-				actualPosition = 0;	 // below player's middle
-			} else if (targetCenter.z > playerCenter.z + 30.0f) {
-				actualPosition = 2;	 // above player's middle
-			} else {
-				actualPosition = 1;	 // player's middle
-			}
+            case FilterPredicate::kIsInitiallyDisabled:
+            {
+                bool isInitiallyDisabled = ctx.target->IsInitiallyDisabled();
+                if (f.isInitiallyDisabled == 0 && isInitiallyDisabled) return false;
+                if (f.isInitiallyDisabled == 1 && !isInitiallyDisabled) return false;
+                return true;
+            }
 
-			if (f.position != actualPosition) {
-				return false;
-			}
-		}
-		if (f.isFirstPerson != 2) {
-			auto* cam = RE::PlayerCamera::GetSingleton();
-			if (!cam || !cam->currentState || !cam->currentState->camera) return false;
-			if (cam->GetRuntimeData().cameraStates[RE::CameraStates::kFirstPerson] ||
-				cam->GetRuntimeData().cameraStates[RE::CameraStates::kVR]) {	// (Hopefully)
-				if (f.isFirstPerson == 0) return false;	// Not first person
-			} else {
-				if (f.isFirstPerson == 1) return false;	// First person
-			}
-		}
-		if (f.isThirdPerson != 2) {
-			auto* cam = RE::PlayerCamera::GetSingleton();
-			if (!cam || !cam->currentState || !cam->currentState->camera) return false;
-			if (cam->GetRuntimeData().cameraStates[RE::CameraStates::kThirdPerson] || 
-				cam->GetRuntimeData().cameraStates[RE::CameraStates::kVRThirdPerson]) {
-				if (f.isThirdPerson == 0) return false;	// Not third person
-			} else {
-				if (f.isThirdPerson == 1) return false;	// Third person
-			}
-		}
-        if (!f.perks.empty()) {
-            if (!ctx.source) return false;
-            auto* actor = ctx.source->As<RE::Actor>();
-            if (!actor) return false;
-            bool hasAny = false;
-            for (const auto& perkID : f.perks) {
-                auto* perk = RE::TESForm::LookupByID<RE::BGSPerk>(perkID);
-                if (perk && actor->HasPerk(perk)) {
-                    hasAny = true;
-                    break;
+            case FilterPredicate::kTime:
+                return CheckTimeFilters(f, GetWorldState(WorldStateSnapshot::kCalendar));
+
+            case FilterPredicate::kLocation:
+                return CheckLocationFilter(f, ctx, scratch.ruleSet->locationAncestry.get());
+
+            case FilterPredicate::kWeather:
+                return CheckWeatherFilter(f, GetWorldState(WorldStateSnapshot::kSky));
+
+            case FilterPredicate::kPosition:
+            {
+                const auto& world = GetWorldState(WorldStateSnapshot::kPlayer);
+                if (!world.playerValid) return false;
+
+                NiPoint3 targetCenter = { 0.0f, 0.0f, 0.0f };
+                const NiPoint3& playerCenter = world.playerCenter;
+
+                if (auto* root = ctx.target->Get3D()) {
+                    targetCenter = root->worldBound.center;
+                } else {
+                    const auto& bmin = ctx.target->GetBoundMin();
+                    const auto& bmax = ctx.target->GetBoundMax();
+                    targetCenter = {
+                        (bmin.x + bmax.x) * 0.5f,
+                        (bmin.y + bmax.y) * 0.5f,
+                        (bmin.z + bmax.z) * 0.5f
+                    };
                 }
+
+                uint32_t actualPosition;
+                if (targetCenter.z < playerCenter.z - 30.0f) {
+                    actualPosition = 0;	 // below player's middle
+                } else if (targetCenter.z > playerCenter.z + 30.0f) {
+                    actualPosition = 2;	 // above player's middle
+                } else {
+                    actualPosition = 1;	 // player's middle
+                }
+
+                return f.position == actualPosition;
             }
-            if (!hasAny) return false;
-        }
-        if (!f.perksNot.empty()) {
-            if (!ctx.source) return false;
-            auto* actor = ctx.source->As<RE::Actor>();
-            if (!actor) return false;
-            for (const auto& perkID : f.perksNot) {
-                auto* perk = RE::TESForm::LookupByID<RE::BGSPerk>(perkID);
-                if (perk && actor->HasPerk(perk)) return false;
+
+            case FilterPredicate::kIsFirstPerson:
+            {
+                const auto& world = GetWorldState(WorldStateSnapshot::kCamera);
+                if (!world.cameraValid) return false;
+                if (world.isFirstPerson) {
+                    if (f.isFirstPerson == 0) return false;	// Not first person
+                } else {
+                    if (f.isFirstPerson == 1) return false;	// First person
+                }
+                return true;
             }
-        }
-        if (!f.spells.empty()) {
-            if (!ctx.source) return false;
-            auto* actor = ctx.source->As<RE::Actor>();
-            if (!actor) return false;
-            bool hasAny = false;
-            for (const auto& spellID : f.spells) {
-                auto* spell = RE::TESForm::LookupByID<RE::SpellItem>(spellID);
-                if (spell && actor->HasSpell(spell)) {
-                    hasAny = true;
-                    break;
+
+            case FilterPredicate::kIsThirdPerson:
+            {
+                const auto& world = GetWorldState(WorldStateSnapshot::kCamera);
+                if (!world.cameraValid) return false;
+                if (world.isThirdPerson) {
+                    if (f.isThirdPerson == 0) return false;	// Not third person
+                } else {
+                    if (f.isThirdPerson == 1) return false;	// Third person
                 }
+                return true;
             }
-            if (!hasAny) return false;
-        }
-        if (!f.spellsNot.empty()) {
-            if (!ctx.source) return false;
-            auto* actor = ctx.source->As<RE::Actor>();
-            if (!actor) return false;
-            for (const auto& spellID : f.spellsNot) {
-                auto* spell = RE::TESForm::LookupByID<RE::SpellItem>(spellID);
-                if (spell && actor->HasSpell(spell)) return false;
+
+            case FilterPredicate::kPerks:
+            {
+                if (!ctx.source) return false;
+                auto* actor = ctx.source->As<RE::Actor>();
+                if (!actor) return false;
+                for (auto* perk : f.perkForms) {
+                    if (actor->HasPerk(perk)) return true;
+                }
+                return false;
             }
-        }
-        if (!f.hasItem.empty()) {
-            if (!ctx.source) return false;
-            bool hasAnyItem = false;
-            for (auto formID : f.hasItem) {
-                if (HasItem(ctx.source, formID)) {
-                    hasAnyItem = true;
-                    break;
+
+            case FilterPredicate::kPerksNot:
+            {
+                if (!ctx.source) return false;
+                auto* actor = ctx.source->As<RE::Actor>();
+                if (!actor) return false;
+                for (auto* perk : f.perkFormsNot) {
+                    if (actor->HasPerk(perk)) return false;
                 }
+                return true;
             }
-            if (!hasAnyItem) return false;
-        }
-        if (!f.hasItemNot.empty()) {
-            if (!ctx.source) return false;
-            for (auto formID : f.hasItemNot) {
-                if (HasItem(ctx.source, formID)) {
-                    return false;
+
+            case FilterPredicate::kSpells:
+            {
+                if (!ctx.source) return false;
+                auto* actor = ctx.source->As<RE::Actor>();
+                if (!actor) return false;
+                for (auto* spell : f.spellForms) {
+                    if (actor->HasSpell(spell)) return true;
                 }
+                return false;
             }
-        }
-        if (!f.level.empty()) {
-            if (!ctx.source) return false;
-            int currentLevel = ctx.source->GetLevel();
-            
-            bool anyLevelMatch = false;
-            for (const auto& condition : f.level) {
-                if (CheckLevelCondition(condition, currentLevel)) {
-                    anyLevelMatch = true;
-                    break;
+
+            case FilterPredicate::kSpellsNot:
+            {
+                if (!ctx.source) return false;
+                auto* actor = ctx.source->As<RE::Actor>();
+                if (!actor) return false;
+                for (auto* spell : f.spellFormsNot) {
+                    if (actor->HasSpell(spell)) return false;
                 }
+                return true;
             }
-            if (!anyLevelMatch) return false;
-        }
-        if (!f.levelNot.empty()) {
-            if (!ctx.source) return false;
-            int currentLevel = ctx.source->GetLevel();
-            
-            for (const auto& condition : f.levelNot) {
-                if (CheckLevelCondition(condition, currentLevel)) {
-                    return false;
-                }
+
+            case FilterPredicate::kHasItem:
+            {
+                if (!ctx.source) return false;
+                return HasAnyItem(ctx.source, f.hasItemForms);
             }
-        }
-        if (!f.actorValue.empty()) {
-            if (!ctx.source) return false;
-            
-            bool anyAVMatch = false;
-            for (const auto& condition : f.actorValue) {
-                if (CheckActorValueCondition(condition, ctx.source)) {
-                    anyAVMatch = true;
-                    break;
+
+            case FilterPredicate::kHasItemNot:
+            {
+                if (!ctx.source) return false;
+                return !HasAnyItem(ctx.source, f.hasItemFormsNot);
+            }
+
+            case FilterPredicate::kLevel:
+            {
+                if (!ctx.source) return false;
+                int currentLevel = ctx.source->GetLevel();
+                for (const auto& condition : f.level) {
+                    if (CheckLevelCondition(condition, currentLevel)) return true;
                 }
+                return false;
             }
-            if (!anyAVMatch) return false;
-        }
-        if (!f.actorValueNot.empty()) {
-            if (!ctx.source) return false;
-            
-            for (const auto& condition : f.actorValueNot) {
-                if (CheckActorValueCondition(condition, ctx.source)) {
-                    return false;
+
+            case FilterPredicate::kLevelNot:
+            {
+                if (!ctx.source) return false;
+                int currentLevel = ctx.source->GetLevel();
+                for (const auto& condition : f.levelNot) {
+                    if (CheckLevelCondition(condition, currentLevel)) return false;
                 }
+                return true;
             }
-        }
-        if (!f.actorKeywords.empty()) {
-            if (!ctx.source) return false;
-            auto* kwf = ctx.source->As<RE::BGSKeywordForm>();
-            if (!kwf) return false;
-            bool hasAny = false;
-            for (auto* kw : f.actorKeywords) {
-                if (kw && kwf->HasKeyword(kw)) {
-                    hasAny = true;
-                    break;
+
+            case FilterPredicate::kActorValue:
+            {
+                if (!ctx.source) return false;
+                for (const auto& condition : f.actorValue) {
+                    if (CheckActorValueCondition(condition, ctx.source)) return true;
                 }
+                return false;
             }
-            if (!hasAny) return false;
-        }
-        if (!f.actorKeywordsNot.empty()) {
-            if (!ctx.source) return false;
-            auto* kwf = ctx.source->As<RE::BGSKeywordForm>();
-            if (kwf) {
-                for (auto* kw : f.actorKeywordsNot) {
-                    if (kw && kwf->HasKeyword(kw)) return false;
+
+            case FilterPredicate::kActorValueNot:
+            {
+                if (!ctx.source) return false;
+                for (const auto& condition : f.actorValueNot) {
+                    if (CheckActorValueCondition(condition, ctx.source)) return false;
                 }
+                return true;
             }
-        }
-        if (!f.actorRaces.empty()) {
-            if (!ctx.source) return false;
-            auto race = ctx.source->GetRace();
-            if (race) {
-                bool matched = false;
+
+            case FilterPredicate::kActorKeywords:
+            {
+                if (!ctx.source) return false;
+                auto* kwf = ctx.source->As<RE::BGSKeywordForm>();
+                if (!kwf) return false;
+                return scratch.ruleSet->keywordCache->HasAny(scratch.ruleSet->keywordIndex, kwf, rule.compiled.actorKeywords);
+            }
+
+            case FilterPredicate::kActorKeywordsNot:
+            {
+                if (!ctx.source) return false;
+                auto* kwf = ctx.source->As<RE::BGSKeywordForm>();
+                return !kwf || !scratch.ruleSet->keywordCache->HasAny(scratch.ruleSet->keywordIndex, kwf, rule.compiled.actorKeywordsNot);
+            }
+
+            case FilterPredicate::kActorRaces:
+            {
+                if (!ctx.source) return false;
+                auto race = ctx.source->GetRace();
+                if (!race) return false;
                 for (auto* allowedRace : f.actorRaces) {
-                    if (allowedRace && allowedRace == race) {
-                        matched = true;
-                        break;
-                    }
+                    if (allowedRace && allowedRace == race) return true;
                 }
-                if (!matched) return false;
-            } else {
                 return false;
             }
-        }
-        if (!f.actorRacesNot.empty()) {
-            if (!ctx.source) return false;
-            auto race = ctx.source->GetRace();
-            if (race) {
-                for (auto* notAllowedRace : f.actorRacesNot) {
-                    if (notAllowedRace && notAllowedRace == race) {
-                        return false;
+
+            case FilterPredicate::kActorRacesNot:
+            {
+                if (!ctx.source) return false;
+                auto race = ctx.source->GetRace();
+                if (race) {
+                    for (auto* notAllowedRace : f.actorRacesNot) {
+                        if (notAllowedRace && notAllowedRace == race) return false;
                     }
                 }
+                return true;
             }
-        }
-        if (f.isSneaking != 2) {
-            if (!ctx.source) return false;
-            bool isSneaking = ctx.source->IsSneaking();
-            if (f.isSneaking == 0 && isSneaking) return false;
-            if (f.isSneaking == 1 && !isSneaking) return false;
-        }
-        if (f.isSwimming != 2) {
-            if (!ctx.source) return false;
-            bool isSwimming = ctx.source->AsActorState()->IsSwimming();
-            if (f.isSwimming == 0 && isSwimming) return false;
-            if (f.isSwimming == 1 && !isSwimming) return false;
-        }
-        if (f.isInCombat != 2) {
-            if (!ctx.source) return false;
-            bool isInCombat = ctx.source->IsInCombat();
-            if (f.isInCombat == 0 && isInCombat) return false;
-            if (f.isInCombat == 1 && !isInCombat) return false;
-        }
-        if (f.isMounted != 2) {
-            if (!ctx.source) return false;
-            bool isMounted = ctx.source->IsOnMount();
-            if (f.isMounted == 0 && isMounted) return false;
-            if (f.isMounted == 1 && !isMounted) return false;
-        }
-        if (f.isSprinting != 2) {
-            if (!ctx.source) return false;
-            bool isSprinting = ctx.source->AsActorState()->IsSprinting();
-            if (f.isSprinting == 0 && isSprinting) return false;
-            if (f.isSprinting == 1 && !isSprinting) return false;
-        }
-        if (f.isWeaponDrawn != 2) {
-            if (!ctx.source) return false;
-            bool isWeaponDrawn = ctx.source->AsActorState()->IsWeaponDrawn();
-            if (f.isWeaponDrawn == 0 && isWeaponDrawn) return false;
-            if (f.isWeaponDrawn == 1 && !isWeaponDrawn) return false;
-        }
-        if (f.isInitiallyDisabled != 2) {
-            if (!ctx.target) return false;
-            bool isInitiallyDisabled = ctx.target->IsInitiallyDisabled();
-            if (f.isInitiallyDisabled == 0 && isInitiallyDisabled) return false;
-            if (f.isInitiallyDisabled == 1 && !isInitiallyDisabled) return false;
-        }
-        if (ctx.isHitEvent) {
-            if (f.destructionStage != -1) {
-                if (f.destructionStage != ctx.destructionStage) return false;
+
+            case FilterPredicate::kIsSneaking:
+            {
+                if (!ctx.source) return false;
+                bool isSneaking = ctx.source->IsSneaking();
+                if (f.isSneaking == 0 && isSneaking) return false;
+                if (f.isSneaking == 1 && !isSneaking) return false;
+                return true;
+            }
+
+            case FilterPredicate::kIsSwimming:
+            {
+                if (!ctx.source) return false;
+                bool isSwimming = ctx.source->AsActorState()->IsSwimming();
+                if (f.isSwimming == 0 && isSwimming) return false;
+                if (f.isSwimming == 1 && !isSwimming) return false;
+                return true;
+            }
+
+            case FilterPredicate::kIsInCombat:
+            {
+                if (!ctx.source) return false;
+                bool isInCombat = ctx.source->IsInCombat();
+                if (f.isInCombat == 0 && isInCombat) return false;
+                if (f.isInCombat == 1 && !isInCombat) return false;
+                return true;
+            }
+
+            case FilterPredicate::kIsMounted:
+            {
+                if (!ctx.source) return false;
+                bool isMounted = ctx.source->IsOnMount();
+                if (f.isMounted == 0 && isMounted) return false;
+                if (f.isMounted == 1 && !isMounted) return false;
+                return true;
+            }
+
+            case FilterPredicate::kIsSprinting:
+            {
+                if (!ctx.source) return false;
+                bool isSprinting = ctx.source->AsActorState()->IsSprinting();
+                if (f.isSprinting == 0 && isSprinting) return false;
+                if (f.isSprinting == 1 && !isSprinting) return false;
+                return true;
             }
-            if (f.allowProjectiles != 1) {
-                if (ctx.projectileSource) return false;
+
+            case FilterPredicate::kIsWeaponDrawn:
+            {
+                if (!ctx.source) return false;
+                bool isWeaponDrawn = ctx.source->AsActorState()->IsWeaponDrawn();
+                if (f.isWeaponDrawn == 0 && isWeaponDrawn) return false;
+                if (f.isWeaponDrawn == 1 && !isWeaponDrawn) return false;
+                return true;
             }
-            if (!f.weaponsTypes.empty() && f.weaponsTypes.find(ctx.weaponType) == f.weaponsTypes.end()) return false;
-            if (!f.weaponsTypesNot.empty() && f.weaponsTypesNot.find(ctx.weaponType) != f.weaponsTypesNot.end()) return false;
-            if (!f.weapons.empty()) {
+
+            // ╔════════════════════════════════════╗
+            // ║          HIT-ONLY FILTERS          ║
+            // ╚════════════════════════════════════╝
+
+            case FilterPredicate::kDestructionStage:
+                return f.destructionStage == ctx.destructionStage;
+
+            case FilterPredicate::kAllowProjectiles:
+                return !ctx.projectileSource;
+
+            case FilterPredicate::kWeaponsTypes:
+                return (f.weaponsTypes & HitMask(ctx.weaponType)) != 0;
+
+            case FilterPredicate::kWeaponsTypesNot:
+                return (f.weaponsTypesNot & HitMask(ctx.weaponType)) == 0;
+
+            case FilterPredicate::kWeapons:
+            {
                 if (!ctx.attackSource) return false;
-                bool matched = false;
-                for (const auto& entry : f.weapons) {
-                    auto* weapon = entry;
-                    if (!weapon) continue;
-                    if (weapon->GetFormID() == ctx.attackSource->GetFormID()) {
-                        matched = true;
-                        break;
-                    }
+                for (auto* weapon : f.weapons) {
+                    if (weapon && weapon->GetFormID() == ctx.attackSource->GetFormID()) return true;
                 }
-                if (!matched) return false;
+                return false;
             }
-            if (!f.weaponsNot.empty()) {
+
+            case FilterPredicate::kWeaponsNot:
+            {
                 if (!ctx.attackSource) return false;
-                for (const auto& entry : f.weaponsNot) {
-                    auto* weapon = entry;
-                    if (!weapon) continue;
-                    if (weapon->GetFormID() == ctx.attackSource->GetFormID()) return false;
+                for (auto* weapon : f.weaponsNot) {
+                    if (weapon && weapon->GetFormID() == ctx.attackSource->GetFormID()) return false;
                 }
+                return true;
             }
-            if (!f.weaponsKeywords.empty()) {
+
+            case FilterPredicate::kWeaponsKeywords:
+            {
                 if (!ctx.attackSource) return false;
                 auto* kwf = ctx.attackSource->As<RE::BGSKeywordForm>();
                 if (!kwf) return false;
-                bool hasAny = false;
-                for (auto* kw : f.weaponsKeywords) {
-                    if (kw && kwf->HasKeyword(kw)) {
-                        hasAny = true;
-                        break;
-                    }
-                }
-                if (!hasAny) return false;
+                return scratch.ruleSet->keywordCache->HasAny(scratch.ruleSet->keywordIndex, kwf, rule.compiled.weaponsKeywords);
             }
-            if (!f.weaponsKeywordsNot.empty()) {
+
+            case FilterPredicate::kWeaponsKeywordsNot:
+            {
                 if (!ctx.attackSource) return false;
                 auto* kwf = ctx.attackSource->As<RE::BGSKeywordForm>();
-                if (kwf) {
-                    for (auto* kw : f.weaponsKeywordsNot) {
-                        if (kw && kwf->HasKeyword(kw)) return false;
-                    }
-                }
+                return !kwf || !scratch.ruleSet->keywordCache->HasAny(scratch.ruleSet->keywordIndex, kwf, rule.compiled.weaponsKeywordsNot);
             }
-            if (!f.projectiles.empty()) {
+
+            case FilterPredicate::kProjectiles:
+            {
                 if (!ctx.projectileSource) return false;
-                bool matched = false;
-                for (const auto& entry : f.projectiles) {
-                    auto* projectile = entry;
-                    if (!projectile) continue;
-                    if (projectile->GetFormID() == ctx.projectileSource->GetFormID()) {
-                        matched = true;
-                        break;
-                    }
+                for (auto* projectile : f.projectiles) {
+                    if (projectile && projectile->GetFormID() == ctx.projectileSource->GetFormID()) return true;
                 }
-                if (!matched) return false;
+                return false;
             }
-            if (!f.projectilesNot.empty()) {
+
+            case FilterPredicate::kProjectilesNot:
+            {
                 if (!ctx.projectileSource) return false;
-                for (const auto& entry : f.projectilesNot) {
-                    auto* projectile = entry;
-                    if (!projectile) continue;
-                    if (projectile->GetFormID() == ctx.projectileSource->GetFormID()) return false;
+                for (auto* projectile : f.projectilesNot) {
+                    if (projectile && projectile->GetFormID() == ctx.projectileSource->GetFormID()) return false;
                 }
+                return true;
             }
-            if (!f.attackTypes.empty() && f.attackTypes.find(ctx.attackType) == f.attackTypes.end()) return false;
-            if (!f.attackTypesNot.empty() && f.attackTypesNot.find(ctx.attackType) != f.attackTypesNot.end()) return false;
-            if (!f.deliveryTypes.empty() && f.deliveryTypes.find(ctx.deliveryType) == f.deliveryTypes.end()) return false;
-            if (!f.deliveryTypesNot.empty() && f.deliveryTypesNot.find(ctx.deliveryType) != f.deliveryTypesNot.end()) return false;
-            if (f.isDualCasting != 2) {
+
+            case FilterPredicate::kAttackTypes:
+                return (f.attackTypes & HitMask(ctx.attackType)) != 0;
+
+            case FilterPredicate::kAttackTypesNot:
+                return (f.attackTypesNot & HitMask(ctx.attackType)) == 0;
+
+            case FilterPredicate::kDeliveryTypes:
+                return (f.deliveryTypes & HitMask(ctx.deliveryType)) != 0;
+
+            case FilterPredicate::kDeliveryTypesNot:
+                return (f.deliveryTypesNot & HitMask(ctx.deliveryType)) == 0;
+
+            case FilterPredicate::kIsDualCasting:
+            {
                 if (!ctx.source) return false;
                 bool isDualCasting = ctx.source->IsDualCasting();
                 if (f.isDualCasting == 0 && isDualCasting) return false;
                 if (f.isDualCasting == 1 && !isDualCasting) return false;
+                return true;
             }
-        }
 
-        if (hasObjectIdentifiers && !objectIdentifierMatch) {
-            return false;
-        }
+            // ╔════════════════════════════════════╗
+            // ║         PROXIMITY FILTERS          ║
+            // ╚════════════════════════════════════╝
 
-        return true;
+            case FilterPredicate::kNearby:
+            case FilterPredicate::kNearbyNot:
+            {
+                if (!ctx.source) return false;
+                const bool exclude = predicate == FilterPredicate::kNearbyNot;
+                const auto& entries = exclude ? f.nearbyNot : f.nearby;
+
+                std::unordered_map<RE::FormID, float> nearbyMap;
+                float maxRadius = 0.0f;
+
+                static thread_local std::mt19937 rng(std::random_device{}());
+
+                for (const auto& nearbyEntry : entries) {
+                    if (!nearbyEntry.form) continue;
+
+                    float actualRadius = nearbyEntry.radius.value;
+                    if (nearbyEntry.radius.useRandom) {
+                        actualRadius = std::uniform_real_distribution<float>(nearbyEntry.radius.min, nearbyEntry.radius.max)(rng);
+                    }
+
+                    nearbyMap[nearbyEntry.form->GetFormID()] = actualRadius;
+                    maxRadius = (std::max)(maxRadius, actualRadius);
+                }
+
+                // An empty inclusion list can never be satisfied, an empty exclusion list never excludes
+                if (nearbyMap.empty()) return exclude;
+
+                auto* tes = RE::TES::GetSingleton();
+                if (!tes) return false;
+
+                bool found = false;
+                auto targetPos = ctx.target->GetPosition();
+                tes->ForEachReferenceInRange(ctx.target, maxRadius, [&](RE::TESObjectREFR* ref) -> RE::BSContainer::ForEachResult {
+                    if (!ref || ref->IsDeleted()) return RE::BSContainer::ForEachResult::kContinue;
+
+                    auto* refBase = ref->GetBaseObject();
+                    if (!refBase) return RE::BSContainer::ForEachResult::kContinue;
+
+                    auto it = nearbyMap.find(refBase->GetFormID());
+                    if (it != nearbyMap.end()) {
+                        float distance = targetPos.GetDistance(ref->GetPosition());
+                        if (distance <= it->second) {
+                            found = true;
+                            return RE::BSContainer::ForEachResult::kStop;
+                        }
+                    }
+
+                    return RE::BSContainer::ForEachResult::kContinue;
+                });
+
+                return exclude ? !found : found;
+            }
+
+            default:
+                return true;
+        }
     }
 
 
@@ -3509,11 +4729,180 @@ namespace OIF {
 //███████╗██║░░░░░██║░░░░░███████╗╚█████╔╝░░░██║░░░██████╔╝  ██║░░██║██║░░░░░██║░░░░░███████╗░░░██║░░░
 //╚══════╝╚═╝░░░░░╚═╝░░░░░╚══════╝░╚════╝░░░░╚═╝░░░╚═════╝░  ╚═╝░░╚═╝╚═╝░░░░░╚═╝░░░░░╚══════╝░░░╚═╝░░░
 
-    void RuleManager::ApplyEffect(const Effect& eff, const RuleContext& ctx, Rule& currentRule) const {     
+    // Cheap, player-facing effects run first in a frame, effects that create or replace references run last
+    static EffectPriority GetEffectPriority(EffectType type) {
+        switch (type) {
+            case EffectType::kShowNotification:
+            case EffectType::kShowMessageBox:
+            case EffectType::kPlaySound:
+            case EffectType::kPlayIdle:
+            case EffectType::kToggleNode:
+            case EffectType::kEnableItem:
+            case EffectType::kDisableItem:
+            case EffectType::kEnableLight:
+            case EffectType::kDisableLight:
+            case EffectType::kLockItem:
+            case EffectType::kUnlockItem:
+                return EffectPriority::kImmediate;
+
+            case EffectType::kSpawnActor:
+            case EffectType::kSwapActor:
+            case EffectType::kSpawnLeveledActor:
+            case EffectType::kSwapLeveledActor:
+            case EffectType::kSwapItem:
+            case EffectType::kSwapLeveledItem:
+            case EffectType::kSpillInventory:
+            case EffectType::kExecuteConsoleCommand:
+            case EffectType::kExecuteConsoleCommandOnItem:
+            case EffectType::kExecuteConsoleCommandOnSource:
+                return EffectPriority::kHeavy;
+
+            default:
+                return EffectPriority::kNormal;
+        }
+    }
+
+    enum class CoalescePolicy : std::uint8_t {
+        kNone,                                                              // every instance runs
+        kKeepOne,                                                           // duplicates add nothing visible, one instance runs
+        kSumCounts                                                          // one instance runs with the counts of all duplicates
+    };
+
+    static CoalescePolicy GetCoalescePolicy(EffectType type) {
+        switch (type) {
+            case EffectType::kPlaySound:
+            case EffectType::kPlayIdle:
+            case EffectType::kShowNotification:
+            case EffectType::kSpawnImpactDataSet:
+            case EffectType::kSpawnEffectShader:
+            case EffectType::kSpawnEffectShaderOnItem:
+            case EffectType::kSpawnArtObject:
+            case EffectType::kSpawnArtObjectOnItem:
+                return CoalescePolicy::kKeepOne;
+
+            case EffectType::kSpawnItem:
+            case EffectType::kSpawnLeveledItem:
+            case EffectType::kAddContainerItem:
+            case EffectType::kAddActorItem:
+            case EffectType::kRemoveContainerItem:
+            case EffectType::kRemoveActorItem:
+                return CoalescePolicy::kSumCounts;
+
+            default:
+                return CoalescePolicy::kNone;
+        }
+    }
+
+    // Effects whose job acts on the source too, duplicates from different sources must not be merged
+    static bool UsesEffectSource(EffectType type) {
+        switch (type) {
+            case EffectType::kPlayIdle:
+            case EffectType::kAddActorItem:
+            case EffectType::kRemoveActorItem:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Delayed or chance-gated items keep their own timing and roll, merging them could drop or move a guaranteed effect
+    static bool IsCoalescable(const Effect& eff) {
+        for (const auto& [form, extData] : eff.items) {
+            if (extData.timer.time.value > 0.0f || extData.timer.time.useRandom) return false;
+            if (extData.chance.value < 100.0f || extData.chance.useRandom) return false;
+        }
+        return true;
+    }
+
+    // Hash of every item field that changes what an effect does; summed counts are left out since they are added on merge
+    static std::uint64_t HashEffectItems(const Effect& eff, bool includeCounts) {
+        std::uint64_t hash = 1469598103934665603ull;
+        const auto mix = [&hash](std::uint64_t value) {
+            hash ^= value;
+            hash *= 1099511628211ull;
+        };
+        const auto mixFloat = [&mix](float value) { mix(std::bit_cast<std::uint32_t>(value)); };
+
+        for (const auto& [form, extData] : eff.items) {
+            mix(reinterpret_cast<std::uintptr_t>(form));
+            mix(reinterpret_cast<std::uintptr_t>(extData.formID));
+            for (const auto& entry : extData.formLists) {
+                mix(entry.formID);
+                mix(static_cast<std::uint32_t>(entry.index));
+            }
+            if (includeCounts) {
+                mix(extData.count.value);
+            }
+            mixFloat(extData.chance.value);
+            mixFloat(extData.timer.time.value);
+            mix(extData.timer.matchFilterRecheck);
+            mix(static_cast<std::uint8_t>(extData.timer.clock));
+            mixFloat(extData.duration);
+            mixFloat(extData.radius.value);
+            mixFloat(extData.scale.value);
+            mix(std::hash<std::string>{}(extData.string));
+            for (const auto& str : extData.strings) {
+                mix(std::hash<std::string>{}(str));
+            }
+            mix(extData.nonDeletable);
+            mix(extData.spawnType);
+            mix(extData.fade);
+            mix(extData.mode);
+            mix(extData.rank);
+            mix(extData.isFormList);
+            mix(static_cast<std::uint32_t>(extData.index));
+            mix(0xFFu);																// item separator
+        }
+        return hash;
+    }
+
+    // Items with index -2 pick their formlist entry from the rule match, so the rule and the picked entry are part of the key
+    static CoalesceKey MakeCoalesceKey(const Effect& eff, CoalescePolicy policy, const RuleScratch& scratch, RE::RefHandle source, RE::RefHandle target) {
+        std::uint64_t hash = HashEffectItems(eff, policy != CoalescePolicy::kSumCounts);
+        const bool usesDynamicIndex = std::ranges::any_of(eff.items, [](const auto& item) {
+            return item.second.isFormList && item.second.index == -2;
+        });
+        if (usesDynamicIndex) {
+            hash = (hash ^ scratch.ruleIdx) * 1099511628211ull;
+            hash = (hash ^ static_cast<std::uint32_t>(scratch.dynamicIndex)) * 1099511628211ull;
+        }
+        return CoalesceKey{
+            hash,
+            UsesEffectSource(eff.type) ? source : 0,
+            target,
+            static_cast<std::uint8_t>(eff.type)
+        };
+    }
+
+    void RuleManager::ApplyEffect(Effect eff, const RuleContext& ctx, const RuleScratch& scratch) const {     
         if (!ctx.target || !ctx.target->GetBaseObject()) return;
         if (!ctx.source || !ctx.source->GetBaseObject()) return;
 
-        SKSE::GetTaskInterface()->AddTask([this, eff, ctx, currentRule]() {
+        RuleContext deferred = ctx;
+        deferred.CaptureHandles();
+
+        const EffectPriority priority = GetEffectPriority(eff.type);
+        const CoalescePolicy policy = GetCoalescePolicy(eff.type);
+        const bool coalesce = policy != CoalescePolicy::kNone && deferred.targetHandle && IsCoalescable(eff);
+        const CoalesceKey key = coalesce ? MakeCoalesceKey(eff, policy, scratch, deferred.sourceHandle, deferred.targetHandle) : CoalesceKey{};
+
+        // Summed effects carry their rolled counts, merged duplicates add theirs
+        std::vector<std::uint32_t> counts;
+        if (coalesce && policy == CoalescePolicy::kSumCounts) {
+            counts.reserve(eff.items.size());
+            for (const auto& [form, extData] : eff.items) {
+                counts.push_back(extData.count.value);
+            }
+        }
+
+        auto job = [this, eff = std::move(eff), ctx = deferred, scratch, keepAlive = scratch.Retain()](std::uint32_t, std::span<const std::uint32_t> mergedCounts) mutable {
+            if (mergedCounts.size() == eff.items.size()) {
+                for (std::size_t i = 0; i < eff.items.size(); ++i) {
+                    eff.items[i].second.count.value = mergedCounts[i];
+                }
+            }
+
+            ctx.ResolveHandles();
             auto* target = ctx.target;
             auto* source = ctx.source;
 
@@ -3566,7 +4955,7 @@ namespace OIF {
                     case EffectType::kSpawnItem: 
                     {
                         ProcessEffect<RE::TESBoundObject, ItemSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* item, const EffectExtendedData& ext) {
                                 return ItemSpawnData(item, ext.string, ext.count, ext.spawnType, ext.fade, ext.scale);
                             },
@@ -3578,7 +4967,7 @@ namespace OIF {
                     case EffectType::kSwapItem:
                     {
                         ProcessEffect<RE::TESBoundObject, ItemSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* item, const EffectExtendedData& ext) {
                                 return ItemSpawnData(item, ext.string, ext.count, ext.spawnType, ext.fade, ext.scale, ext.nonDeletable);
                             },
@@ -3590,7 +4979,7 @@ namespace OIF {
                     case EffectType::kSpawnLeveledItem:
                     {
                         ProcessEffect<RE::TESLevItem, LvlItemSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* lvli, const EffectExtendedData& ext) {
                                 return LvlItemSpawnData(lvli, ext.string, ext.count, ext.spawnType, ext.fade, ext.scale);
                             },
@@ -3602,7 +4991,7 @@ namespace OIF {
                     case EffectType::kSwapLeveledItem:
                     {
                         ProcessEffect<RE::TESLevItem, LvlItemSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* lvli, const EffectExtendedData& ext) {
                                 return LvlItemSpawnData(lvli, ext.string, ext.count, ext.spawnType, ext.fade, ext.scale, ext.nonDeletable);
                             },
@@ -3614,7 +5003,7 @@ namespace OIF {
                     case EffectType::kSpawnSpell:
                     {
                         ProcessEffect<RE::SpellItem, SpellSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* spell, const EffectExtendedData& ext) {
                                 return SpellSpawnData(spell, ext.count, ext.radius);
                             },
@@ -3626,7 +5015,7 @@ namespace OIF {
                     case EffectType::kSpawnSpellOnItem:
                     {
                         ProcessEffect<RE::SpellItem, SpellSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* spell, const EffectExtendedData& ext) {
                                 return SpellSpawnData(spell, ext.count);
                             },
@@ -3638,7 +5027,7 @@ namespace OIF {
                     case EffectType::kSpawnLeveledSpell:
                     {
                         ProcessEffect<RE::TESLevSpell, LvlSpellSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* lvls, const EffectExtendedData& ext) {
                                 return LvlSpellSpawnData(lvls, ext.count, ext.radius);
                             },
@@ -3650,7 +5039,7 @@ namespace OIF {
                     case EffectType::kSpawnLeveledSpellOnItem:
                     {
                         ProcessEffect<RE::TESLevSpell, LvlSpellSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* lvls, const EffectExtendedData& ext) {
                                 return LvlSpellSpawnData(lvls, ext.count);
                             },
@@ -3662,7 +5051,7 @@ namespace OIF {
                 	case EffectType::kApplySpell:
 					{
 						ProcessEffect<void, SpellSpawnData>(
-							eff, ctx, currentRule, false,
+							eff, ctx, scratch, false,
 							[](std::nullptr_t, const EffectExtendedData& ext) {
 								return SpellSpawnData(nullptr, ext.count, ext.radius);
 							},
@@ -3674,7 +5063,7 @@ namespace OIF {
                     case EffectType::kSpawnActor:
                     {
                         ProcessEffect<RE::TESNPC, ActorSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* actor, const EffectExtendedData& ext) {
                                 return ActorSpawnData(actor, ext.string, ext.count, ext.spawnType, ext.fade, ext.scale);
                             },
@@ -3686,7 +5075,7 @@ namespace OIF {
                     case EffectType::kSwapActor:
                     {
                         ProcessEffect<RE::TESNPC, ActorSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* actor, const EffectExtendedData& ext) {
                                 return ActorSpawnData(actor, ext.string, ext.count, ext.spawnType, ext.fade, ext.scale, ext.nonDeletable);
                             },
@@ -3698,7 +5087,7 @@ namespace OIF {
                     case EffectType::kSpawnLeveledActor:
                     {
                         ProcessEffect<RE::TESLevCharacter, LvlActorSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* lvlc, const EffectExtendedData& ext) {
                                 return LvlActorSpawnData(lvlc, ext.string, ext.count, ext.spawnType, ext.fade, ext.scale);
                             },
@@ -3710,7 +5099,7 @@ namespace OIF {
                     case EffectType::kSwapLeveledActor:
                     {
                         ProcessEffect<RE::TESLevCharacter, LvlActorSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* lvlc, const EffectExtendedData& ext) {
                                 return LvlActorSpawnData(lvlc, ext.string, ext.count, ext.spawnType, ext.fade, ext.scale, ext.nonDeletable);
                             },
@@ -3722,7 +5111,7 @@ namespace OIF {
                     case EffectType::kSpawnImpactDataSet:
                     {
                         ProcessEffect<RE::BGSImpactDataSet, ImpactDataSetSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* impact, const EffectExtendedData& ext) {
                                 return ImpactDataSetSpawnData(impact, ext.count);
                             },
@@ -3734,7 +5123,7 @@ namespace OIF {
                     case EffectType::kSpawnExplosion:
                     {
                         ProcessEffect<RE::BGSExplosion, ExplosionSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* explosion, const EffectExtendedData& ext) {
                                 return ExplosionSpawnData(explosion, ext.string, ext.count, ext.spawnType, ext.fade);
                             },
@@ -3746,7 +5135,7 @@ namespace OIF {
                     case EffectType::kPlaySound:
                     {
                         ProcessEffect<RE::BGSSoundDescriptorForm, SoundSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* sound, const EffectExtendedData& ext) {
                                 return SoundSpawnData(sound, ext.count);
                             },
@@ -3758,7 +5147,7 @@ namespace OIF {
                     case EffectType::kApplyIngestible:
                     {
                         ProcessEffect<void, IngestibleApplyData>(
-                            eff, ctx, currentRule, false,
+                            eff, ctx, scratch, false,
                             [](std::nullptr_t, const EffectExtendedData& ext) {
                                 return IngestibleApplyData(nullptr, ext.count, ext.radius);
                             },
@@ -3770,7 +5159,7 @@ namespace OIF {
                     case EffectType::kApplyOtherIngestible:
                     {
                         ProcessEffect<RE::MagicItem, IngestibleApplyData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* ingestible, const EffectExtendedData& ext) {
                                 return IngestibleApplyData(ingestible, ext.count, ext.radius);
                             },
@@ -3782,7 +5171,7 @@ namespace OIF {
                     case EffectType::kSpawnLight:
                     {
                         ProcessEffect<RE::TESObjectLIGH, LightSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* light, const EffectExtendedData& ext) {
                                 return LightSpawnData(light, ext.string, ext.count, ext.spawnType, ext.fade, ext.scale);
                             },
@@ -3794,7 +5183,7 @@ namespace OIF {
                     case EffectType::kRemoveLight:
                     {
                         ProcessEffect<void, LightRemoveData>(
-                            eff, ctx, currentRule, false,
+                            eff, ctx, scratch, false,
 							[](std::nullptr_t, const EffectExtendedData& ext) {
                                 return LightRemoveData(ext.radius);
                             },
@@ -3806,7 +5195,7 @@ namespace OIF {
                     case EffectType::kEnableLight:
                     {
                         ProcessEffect<void, LightRemoveData>(
-                            eff, ctx, currentRule, false,
+                            eff, ctx, scratch, false,
 							[](std::nullptr_t, const EffectExtendedData& ext) {
                                 return LightRemoveData(ext.radius);
                             },
@@ -3818,7 +5207,7 @@ namespace OIF {
                     case EffectType::kDisableLight:
                     {
                         ProcessEffect<void, LightRemoveData>(
-                            eff, ctx, currentRule, false,
+                            eff, ctx, scratch, false,
 							[](std::nullptr_t, const EffectExtendedData& ext) {
                                 return LightRemoveData(ext.radius);
                             },
@@ -3830,7 +5219,7 @@ namespace OIF {
                     case EffectType::kPlayIdle:
                     {
                         ProcessEffect<void, PlayIdleData>(
-                            eff, ctx, currentRule, false,
+                            eff, ctx, scratch, false,
                             [&ctx](std::nullptr_t, const EffectExtendedData& ext) {
                                 return PlayIdleData(ctx.source, ext.string, ext.duration > 0.0f ? ext.duration : 1.0f);
                             },
@@ -3842,7 +5231,7 @@ namespace OIF {
                     case EffectType::kSpawnEffectShader:
                     {
                         ProcessEffect<RE::TESEffectShader, EffectShaderSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* shader, const EffectExtendedData& ext) {
                                 return EffectShaderSpawnData(shader, ext.count, ext.radius, ext.duration);
                             },
@@ -3854,7 +5243,7 @@ namespace OIF {
                     case EffectType::kSpawnEffectShaderOnItem:
                     {
                         ProcessEffect<RE::TESEffectShader, EffectShaderSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* shader, const EffectExtendedData& ext) {
                                 return EffectShaderSpawnData(shader, ext.count, ext.radius, ext.duration);
                             },
@@ -3866,7 +5255,7 @@ namespace OIF {
                     case EffectType::kToggleNode:
                     {
                         ProcessEffect<void, NodeData>(
-                            eff, ctx, currentRule, false,
+                            eff, ctx, scratch, false,
                             [](std::nullptr_t, const EffectExtendedData& ext) {
                                 return NodeData(ext.mode, ext.strings);
                             },
@@ -3878,7 +5267,7 @@ namespace OIF {
                     case EffectType::kSpawnArtObject:
                     {
                         ProcessEffect<RE::BGSArtObject, ArtObjectData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* artObject, const EffectExtendedData& ext) {
                                 return ArtObjectData(artObject, ext.count, ext.radius, ext.duration);
                             },
@@ -3890,7 +5279,7 @@ namespace OIF {
                     case EffectType::kSpawnArtObjectOnItem:
                     {
                         ProcessEffect<RE::BGSArtObject, ArtObjectData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* artObject, const EffectExtendedData& ext) {
                                 return ArtObjectData(artObject, ext.count, ext.radius, ext.duration);
                             },
@@ -3928,7 +5317,7 @@ namespace OIF {
                     case EffectType::kRemoveActorItem:
                     {
                         ProcessEffect<RE::TESBoundObject, InventoryData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* item, const EffectExtendedData& ext) {
                                 return InventoryData(item, ext.count);
                             },
@@ -3948,7 +5337,7 @@ namespace OIF {
                     case EffectType::kAddActorSpell:
                     {
                         ProcessEffect<RE::SpellItem, SpellSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* spell, const EffectExtendedData& ext) {
                                 return SpellSpawnData(spell, ext.count);
                             },
@@ -3960,7 +5349,7 @@ namespace OIF {
                     case EffectType::kRemoveActorSpell:
                     {
                         ProcessEffect<RE::SpellItem, SpellSpawnData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* spell, const EffectExtendedData& /*ext*/) {
                                 return SpellSpawnData(spell);
                             },
@@ -3972,7 +5361,7 @@ namespace OIF {
                     case EffectType::kAddActorPerk:
                     {
                         ProcessEffect<RE::BGSPerk, PerkData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* perk, const EffectExtendedData& ext) {
                                 return PerkData(perk, ext.rank);
                             },
@@ -3984,7 +5373,7 @@ namespace OIF {
                     case EffectType::kRemoveActorPerk:
                     {
                         ProcessEffect<RE::BGSPerk, PerkData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](auto* perk, const EffectExtendedData& /*ext*/) {
                                 return PerkData(perk);
                             },
@@ -3996,7 +5385,7 @@ namespace OIF {
                     case EffectType::kExecuteConsoleCommand:
                     {
                         ProcessEffect<void, StringData>(
-                            eff, ctx, currentRule, true,
+                            eff, ctx, scratch, true,
                             [](std::nullptr_t, const EffectExtendedData& ext) {
                                 return StringData(ext.string, ext.radius);
                             },
@@ -4008,7 +5397,7 @@ namespace OIF {
                     case EffectType::kExecuteConsoleCommandOnItem:
                     {
                         ProcessEffect<void, StringData>(
-                            eff, ctx, currentRule, false,
+                            eff, ctx, scratch, false,
                             [](std::nullptr_t, const EffectExtendedData& ext) {
                                 return StringData(ext.string);
                             },
@@ -4020,7 +5409,7 @@ namespace OIF {
 					case EffectType::kExecuteConsoleCommandOnSource:
 					{
 						ProcessEffect<void, StringData>(
-							eff, ctx, currentRule, false,
+							eff, ctx, scratch, false,
 							[](std::nullptr_t, const EffectExtendedData& ext) {
 								return StringData(ext.string);
 							},
@@ -4031,7 +5420,7 @@ namespace OIF {
                     case EffectType::kShowNotification:
                     {
                         ProcessEffect<void, StringData>(
-                            eff, ctx, currentRule, false,
+                            eff, ctx, scratch, false,
                             [](std::nullptr_t, const EffectExtendedData& ext) {
                                 return StringData(ext.string);
                             },
@@ -4043,7 +5432,7 @@ namespace OIF {
                     case EffectType::kShowMessageBox: 
                     {
                         ProcessEffect<void, StringData>(
-                            eff, ctx, currentRule, false,
+                            eff, ctx, scratch, false,
                             [](std::nullptr_t, const EffectExtendedData& ext) {
                                 return StringData(ext.string);
                             },
@@ -4060,7 +5449,13 @@ namespace OIF {
             } catch (...) {
                 logger::error("Unknown exception in effect task");
             }
-        });
+        };
+
+        if (coalesce) {
+            EffectQueue::GetSingleton()->Push(priority, std::move(job), key, std::move(counts));
+        } else {
+            EffectQueue::GetSingleton()->Push(priority, std::move(job));
+        }
     }
     
 
@@ -4075,43 +5470,44 @@ namespace OIF {
 // ║        CLEAN-UP FUNCTUION          ║
 // ╚════════════════════════════════════╝
 
-    void RuleManager::CleanupCounters() {
-        // Prevent unbounded growth of interaction counter map
-        if (_interactionsCounts.size() > 500) {
-            logger::debug("Clearing interactions cache: {} entries", _interactionsCounts.size());
-            _interactionsCounts.clear();
-        }
-
-        if (_limitCounts.size() > 500) {
-            std::size_t removedCount = 0;
-            auto it = _limitCounts.begin();
-            while (it != _limitCounts.end()) {
-                if (it->second == 0) {  // Remove only unused limits
-                    it = _limitCounts.erase(it);
-                    ++removedCount;
-                } else {
-                    ++it;
-                }
-            }
-            logger::debug("Cleaned {} unused limit entries, remaining: {}", removedCount, _limitCounts.size());
-        }
+    // Hits on the same target within this window come from different sinks reporting one hit
+    static constexpr auto kHitDedupWindow = std::chrono::milliseconds(250);
 
-        // Emergency cleanup if counts grow too large
-        if (_interactionsCounts.size() > 1000) {
-            logger::warn("Emergency interactions cleanup!");
-            _interactionsCounts.clear();
-        }
+    // Milliseconds since the plugin started, wraps after 49 days which unsigned differences tolerate
+    static std::uint32_t TimerNow() {
+        static const auto start = std::chrono::steady_clock::now();
+        return static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+    }
 
-        if (_limitCounts.size() > 1000) {
-            logger::warn("Emergency limits cleanup - removing only zero values!");
-            auto it = _limitCounts.begin();
-            while (it != _limitCounts.end()) {
-                if (it->second == 0) {
-                    it = _limitCounts.erase(it);
-                } else {
-                    ++it;
-                }
+    void RuleManager::CleanupCounters() {
+        std::lock_guard lock(_counterMutex);
+
+        // Each call examines a fixed number of slots, the clock hand resumes where the previous call stopped
+        constexpr std::size_t kSlotsPerCall = 64;
+        constexpr std::size_t kExpiredHitsPerCall = 64;
+        constexpr std::uint32_t kUpdateTimerMaxAge = 3600;
+
+        const std::uint32_t now = CounterTable::Now();
+        const float maxAge = Settings::GetSingleton()->interactionCounterMaxAge;
+        const std::uint32_t interactionMaxAge = maxAge > 0.0f ? static_cast<std::uint32_t>(std::max(maxAge, 1.0f)) : 0;
+
+        // Interaction progress is temporary and ages out, limit counters are only dropped once zero
+        _interactionsCounts.Maintain(now, interactionMaxAge, kSlotsPerCall);
+        _limitCounts.Maintain(now, 0, kSlotsPerCall);
+        _updateTimers.Maintain(now, kUpdateTimerMaxAge, kSlotsPerCall);
+
+        // Hit deduplication entries expire in insertion order
+        const auto hitNow = std::chrono::steady_clock::now();
+        for (std::size_t n = 0; n < kExpiredHitsPerCall && !recentlyProcessedQueue.empty(); ++n) {
+            const auto& [ref, time] = recentlyProcessedQueue.front();
+            if (hitNow - time <= kHitDedupWindow) break;
+
+            // A newer entry for the same reference has its own place further back in the queue
+            auto it = recentlyProcessedItems.find(ref);
+            if (it != recentlyProcessedItems.end() && it->second == time) {
+                recentlyProcessedItems.erase(it);
             }
+            recentlyProcessedQueue.pop_front();
         }
     }
 
@@ -4119,17 +5515,43 @@ namespace OIF {
 // ║          TRIGGER FUNCTION          ║
 // ╚════════════════════════════════════╝
 
+    // Returns a copy of the effect with its random count, scale and radius rolled for this application
+    static Effect RollEffect(const Effect& eff) {
+        static thread_local std::mt19937 rng(std::random_device{}());
+
+        Effect rolled = eff;
+        for (auto& [form, extData] : rolled.items) {
+            if (extData.count.useRandom) {
+                extData.count.value = std::uniform_int_distribution<std::uint32_t>(extData.count.min, extData.count.max)(rng);
+            }
+            if (extData.scale.useRandom) {
+                extData.scale.value = std::uniform_real_distribution<float>(extData.scale.min, extData.scale.max)(rng);
+            }
+            if (extData.radius.useRandom) {
+                extData.radius.value = std::uniform_real_distribution<float>(extData.radius.min, extData.radius.max)(rng);
+            }
+        }
+        return rolled;
+    }
+
     void RuleManager::Trigger(const RuleContext& ctx)
     {
-        std::unique_lock lock(_ruleMutex);
+        TriggerBatch(std::span<const RuleContext>(&ctx, 1));
+    }
+
+    void RuleManager::TriggerBatch(std::span<const RuleContext> batch)
+    {
+        if (batch.empty()) return;
 
-        // Save critical data to prevent potential loss
-        auto localTarget = ctx.target;
-        auto localSource = ctx.source;
-        if (!localTarget || localTarget->IsDeleted() || !localSource || localSource->IsDeleted()) return;
+        // The whole batch is evaluated against one snapshot
+        auto ruleSet = _ruleSet.load(std::memory_order_acquire);
+        if (!ruleSet) return;
 
-        auto targetFormID = localTarget->GetFormID();
-        auto sourceFormID = localSource->GetFormID();
+        // Reuse the thread's buffer without breaking if a batch is ever started from inside another one
+        static thread_local std::vector<const RuleContext*> acceptedBuffer;
+        std::vector<const RuleContext*> accepted;
+        accepted.swap(acceptedBuffer);
+        accepted.clear();
 
 		// ╔════════════════════════════════════╗
 		// ║           DEDUPLICATION            ║
@@ -4138,62 +5560,101 @@ namespace OIF {
 		// The reason is that kHit event is used by multiple sinks and hooks, which can collide
 
         auto now = std::chrono::steady_clock::now();
+        std::unique_lock counterLock(_counterMutex, std::defer_lock);
 
-        if (ctx.event == EventType::kHit) {
+        for (const auto& ctx : batch) {
+            auto localTarget = ctx.target;
+            auto localSource = ctx.source;
+            if (!localTarget || localTarget->IsDeleted() || !localSource || localSource->IsDeleted()) continue;
 
-            static bool isFirstCall = true;
-            if (isFirstCall) {
-                lastCleanupTime = now;
-                isFirstCall = false;
-            }
+            if (ctx.event == EventType::kHit) {
+                // One lock per batch, expired entries are removed by CleanupCounters
+                if (!counterLock.owns_lock()) counterLock.lock();
 
-            if (now - lastCleanupTime > std::chrono::milliseconds(50)) {
-                auto it = recentlyProcessedItems.begin();
-                while (it != recentlyProcessedItems.end()) {
-                    if (now - it->second > std::chrono::milliseconds(250)) {
-                        it = recentlyProcessedItems.erase(it);
-                    } else {
-                        ++it;
-                    }
+                auto [it, inserted] = recentlyProcessedItems.try_emplace(localTarget, now);
+                if (!inserted) {
+                    if (now - it->second <= kHitDedupWindow) continue;
+                    it->second = now;
                 }
-                lastCleanupTime = now;
-            }
-                    
-            if (recentlyProcessedItems.find(localTarget) != recentlyProcessedItems.end()) {
-                return;
+                recentlyProcessedQueue.emplace_back(localTarget, now);
             }
-            
-            recentlyProcessedItems[localTarget] = now;
+
+            accepted.push_back(&ctx);
+        }
+
+        if (counterLock.owns_lock()) counterLock.unlock();
+
+        for (const auto* ctx : accepted) {
+            TriggerRules(ruleSet, *ctx);
         }
 
-		// Walk through every compatible rule and apply those whose filters match
-		for (std::size_t ruleIdx = 0; ruleIdx < _rules.size(); ++ruleIdx) {
-			Rule& r = _rules[ruleIdx];
+        accepted.clear();
+        accepted.swap(acceptedBuffer);
+    }
+
+    void RuleManager::TriggerRules(const std::shared_ptr<const RuleSet>& ruleSet, const RuleContext& ctx)
+    {
+        auto localTarget = ctx.target;
+        auto targetFormID = localTarget->GetFormID();
+        auto sourceFormID = ctx.source->GetFormID();
+
+		auto evIdx = static_cast<std::size_t>(ctx.event);
+		if (evIdx >= kEventTypeCount) return;
+
+		// Narrow the rules registered for this event down to those whose object identifiers can match the target
+		static thread_local std::vector<std::size_t> candidateRules;
+		CollectCandidateRules(ruleSet->eventRules[evIdx], localTarget->GetBaseObject(), candidateRules);
 
-			if (std::find(r.events.begin(), r.events.end(), ctx.event) == r.events.end()) continue;
+		_eventTriggerCounts[evIdx].fetch_add(1, std::memory_order_relaxed);
+		_eventVisitedRuleCounts[evIdx].fetch_add(candidateRules.size(), std::memory_order_relaxed);
+
+		static thread_local std::mt19937 rng(std::random_device{}());
+
+		// Walk through every candidate rule and apply those whose filters match
+		for (std::size_t ruleIdx : candidateRules) {
+			const Rule& r = ruleSet->rules[ruleIdx];
+
+			// Per-evaluation state, never written back into the shared ruleset
+			RuleScratch scratch{ ruleSet.get(), ruleIdx, 0 };
 
 			// ╔════════════════════════════════════╗
 			// ║         RANDOM ROLLS BLOCK         ║
 			// ╚════════════════════════════════════╝
 
-			static thread_local std::mt19937 rng(std::random_device{}());
+			std::uint32_t limitValue = r.filter.limit.value;
+			std::uint32_t interactionsValue = r.filter.interactions.value;
+
+			if (r.filter.limit.useRandom || r.filter.interactions.useRandom) {
+				std::lock_guard counterLock(_counterMutex);
 
-			// Roll for limit if needed
-			if (r.filter.limit.useRandom && !r.filter.limit.hasRolled) {
-				r.filter.limit.value = std::uniform_int_distribution<std::uint32_t>(r.filter.limit.min, r.filter.limit.max)(rng);
-				r.filter.limit.hasRolled = true;
+				// Rolls belong to the published snapshot, a trigger still running on a replaced one keeps the parsed values
+				if (ruleSet == _ruleSet.load(std::memory_order_relaxed) && ruleIdx < _ruleRolls.size()) {
+					auto& rolls = _ruleRolls[ruleIdx];
+
+					// Roll for limit if needed
+					if (r.filter.limit.useRandom && !rolls.limitRolled) {
+						rolls.limit = std::uniform_int_distribution<std::uint32_t>(r.filter.limit.min, r.filter.limit.max)(rng);
+						rolls.limitRolled = true;
+					}
+
+					// Roll for interactions if needed
+					if (r.filter.interactions.useRandom && !rolls.interactionsRolled) {
+						rolls.interactions = std::uniform_int_distribution<std::uint32_t>(r.filter.interactions.min, r.filter.interactions.max)(rng);
+						rolls.interactionsRolled = true;
+					}
+
+					if (r.filter.limit.useRandom) limitValue = rolls.limit;
+					if (r.filter.interactions.useRandom) interactionsValue = rolls.interactions;
+				}
 			}
 
-			// Roll for interactions if needed
-			if (r.filter.interactions.useRandom && !r.filter.interactions.hasRolled) {
-				r.filter.interactions.value = std::uniform_int_distribution<std::uint32_t>(r.filter.interactions.min, r.filter.interactions.max)(rng);
-				r.filter.interactions.hasRolled = true;
+			// Rules whose chance roll does not depend on counters or timers roll before any predicate runs
+			if (r.compiled.earlyChance && r.filter.chance.value < 100.0f) {
+				float earlyRoll = std::uniform_real_distribution<float>(0.f, 100.f)(rng);
+				if (earlyRoll >= r.filter.chance.value) continue;
 			}
 
-			r.dynamicIndex = 0;
-			if (!MatchFilter(r.filter, ctx, r)) continue;
-			if (!CheckLocationFilter(r.filter, ctx)) return;
-			if (!CheckWeatherFilter(r.filter)) return;
+			if (!MatchFilter(r, ctx, scratch)) continue;
 
 			// ╔════════════════════════════════════╗
 			// ║         LIMIT CHECK BLOCK          ║
@@ -4201,14 +5662,15 @@ namespace OIF {
 			// Important data which will be partially saved
 
 			bool limitCheckPassed = true;
-			if (r.filter.limit.value > 0) {
+			if (limitValue > 0) {
+				std::lock_guard counterLock(_counterMutex);
 				Key limitKey{
 					sourceFormID,
 					targetFormID,
 					static_cast<std::uint16_t>(ruleIdx)
 				};
-				std::uint32_t& limitCnt = _limitCounts[limitKey];
-				if (limitCnt >= r.filter.limit.value) {
+				std::uint32_t& limitCnt = _limitCounts.Touch(limitKey, CounterTable::Now());
+				if (limitCnt >= limitValue) {
 					limitCheckPassed = false;
 				} else {
 					++limitCnt;
@@ -4222,19 +5684,22 @@ namespace OIF {
 			// Temporary data - can be reset
 
 			bool interactionCheckPassed = true;
-			if (r.filter.interactions.value > 1) {
+			if (interactionsValue > 1) {
+				std::lock_guard counterLock(_counterMutex);
 				Key interactionKey{
 					sourceFormID,
 					targetFormID,
 					static_cast<std::uint16_t>(ruleIdx)
 				};
-				std::uint32_t& interactionsCnt = _interactionsCounts[interactionKey];
-				if (++interactionsCnt < r.filter.interactions.value) {
+				std::uint32_t& interactionsCnt = _interactionsCounts.Touch(interactionKey, CounterTable::Now());
+				if (++interactionsCnt < interactionsValue) {
 					interactionCheckPassed = false;
 				} else {
 					interactionsCnt = 0;
-					// Reset hasRolled when interactions accumulated
-					r.filter.interactions.hasRolled = false;
+					// Re-roll interactions when accumulated
+					if (r.filter.interactions.useRandom && ruleSet == _ruleSet.load(std::memory_order_relaxed) && ruleIdx < _ruleRolls.size()) {
+						_ruleRolls[ruleIdx].interactionsRolled = false;
+					}
 				}
 			}
 			if (!interactionCheckPassed) continue;
@@ -4243,106 +5708,63 @@ namespace OIF {
 			// ║         TIMER CHECK BLOCK          ║
 			// ╚════════════════════════════════════╝
 
-			bool timerBlockApplied = false;
 			if (r.filter.timer.time.value > 0.0f) {
 				if (ctx.event == EventType::kOnUpdate) {
-					static std::map<Key, std::chrono::steady_clock::time_point> updateTimers;
-					static std::chrono::steady_clock::time_point lastTimerCleanup = std::chrono::steady_clock::now();
+					std::lock_guard counterLock(_counterMutex);
 
 					Key ruleKey{
 						sourceFormID,
 						targetFormID,
 						static_cast<std::uint16_t>(ruleIdx)
 					};
-					auto currentTime = std::chrono::steady_clock::now();
-
-					if (currentTime - lastTimerCleanup > std::chrono::minutes(5)) {
-						auto cleanupThreshold = currentTime - std::chrono::hours(1);
-						auto it = updateTimers.begin();
-						while (it != updateTimers.end()) {
-							if (it->second < cleanupThreshold) {
-								it = updateTimers.erase(it);
-							} else {
-								++it;
-							}
-						}
-						lastTimerCleanup = currentTime;
-
-						if (updateTimers.size() > 500) {
-							logger::warn("Emergency cleanup of updateTimers: {} entries", updateTimers.size());
-							updateTimers.clear();
-						}
-					}
-
-					auto it = updateTimers.find(ruleKey);
-					if (it == updateTimers.end()) {
-						updateTimers[ruleKey] = currentTime;
+					// Zero marks a new timer, so a start time of zero is stored as one
+					const std::uint32_t clockNow = r.filter.timer.clock == TimerClock::kGameTime ?
+						static_cast<std::uint32_t>(static_cast<std::uint64_t>(Scheduler::GetSingleton()->GetGameTime() * 1000.0)) : TimerNow();
+					const std::uint32_t currentTime = std::max<std::uint32_t>(clockNow, 1);
+
+					std::uint32_t& startedAt = _updateTimers.Touch(ruleKey, CounterTable::Now());
+					if (startedAt == 0) {
+						startedAt = currentTime;
 						continue;
 					} else {
-						auto elapsed = std::chrono::duration<float>(currentTime - it->second).count();
+						auto elapsed = static_cast<float>(currentTime - startedAt) / 1000.0f;
 						if (elapsed < r.filter.timer.time.value) {
 							continue;
 						} else {
-							it->second = currentTime;
+							startedAt = currentTime;
 						}
 					}
 				} else {
-					static std::vector<std::future<void>> timerTasks;
-					static std::mutex timerMutex;
+					RuleContext deferred = ctx;
+					deferred.CaptureHandles();
 
-					auto timerFuture = std::async(std::launch::async, [this, r, ctx, timerBlockApplied, timer = r.filter.timer.time.value]() {
-						std::this_thread::sleep_for(std::chrono::duration<float>(timer));
+					Scheduler::GetSingleton()->Schedule(r.filter.timer.time.value, [this, scratch, keepAlive = scratch.Retain(), ctx = deferred]() mutable {
+						ctx.ResolveHandles();
+						auto* target = ctx.target;
+						auto* source = ctx.source;
 
-						SKSE::GetTaskInterface()->AddTask([this, r, ctx, timerBlockApplied]() mutable {
-							auto* target = ctx.target;
-							auto* source = ctx.source;
-
-							if (!target || target->IsDeleted()) {
-								logger::warn("Target is invalid or deleted after timer");
-								return;
-							}
+						if (!target || target->IsDeleted()) {
+							logger::warn("Target is invalid or deleted after timer");
+							return;
+						}
 
-							if (!source || source->IsDeleted()) {
-								logger::warn("Source is invalid or deleted after timer");
-								return;
-							}
+						if (!source || source->IsDeleted()) {
+							logger::warn("Source is invalid or deleted after timer");
+							return;
+						}
 
-							if (r.filter.timer.matchFilterRecheck == 1) {
-								if (!MatchFilter(r.filter, ctx, r)) return;
-							}
+						const Rule& rule = scratch.GetRule();
+						if (rule.filter.timer.matchFilterRecheck == 1) {
+							if (!MatchFilter(rule, ctx, scratch)) return;
+						}
 
-							float globalRoll = std::uniform_real_distribution<float>(0.f, 100.f)(rng);
-							if (globalRoll < r.filter.chance.value) {
-								for (auto& eff : r.effects) {
-									for (auto& [form, extData] : eff.items) {
-										if (extData.count.useRandom) {
-											extData.count.value = std::uniform_int_distribution<std::uint32_t>(extData.count.min, extData.count.max)(rng);
-										}
-										if (extData.scale.useRandom) {
-											extData.scale.value = std::uniform_real_distribution<float>(extData.scale.min, extData.scale.max)(rng);
-										}
-										if (extData.radius.useRandom) {
-											extData.radius.value = std::uniform_real_distribution<float>(extData.radius.min, extData.radius.max)(rng);
-										}
-									}
-									ApplyEffect(eff, ctx, r);
-								}
-								timerBlockApplied = true;
+						float globalRoll = std::uniform_real_distribution<float>(0.f, 100.f)(rng);
+						if (globalRoll < rule.filter.chance.value) {
+							for (const auto& eff : rule.effects) {
+								ApplyEffect(RollEffect(eff), ctx, scratch);
 							}
-						});
-					});
-
-					{
-						std::lock_guard<std::mutex> timerlock(timerMutex);
-						timerTasks.push_back(std::move(timerFuture));
-
-						timerTasks.erase(
-							std::remove_if(timerTasks.begin(), timerTasks.end(),
-								[](const std::future<void>& f) {
-									return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
-								}),
-							timerTasks.end());
-					}
+						}
+					}, deferred.targetHandle, r.filter.timer.clock);
 
 					continue;
 				}
@@ -4352,31 +5774,16 @@ namespace OIF {
 			// ║          EFFECTS APPLYING          ║
 			// ╚════════════════════════════════════╝
 
-			if (!timerBlockApplied) {
+			bool chancePassed = r.compiled.earlyChance;
+			if (!chancePassed) {
 				float globalRoll = std::uniform_real_distribution<float>(0.f, 100.f)(rng);
-				if (globalRoll < r.filter.chance.value) {
-					for (auto& eff : r.effects) {
-						for (auto& [form, extData] : eff.items) {
-							if (extData.count.useRandom) {
-								extData.count.value = std::uniform_int_distribution<std::uint32_t>(extData.count.min, extData.count.max)(rng);
-							}
-							if (extData.scale.useRandom) {
-								extData.scale.value = std::uniform_real_distribution<float>(extData.scale.min, extData.scale.max)(rng);
-							}
-							if (extData.radius.useRandom) {
-								extData.radius.value = std::uniform_real_distribution<float>(extData.radius.min, extData.radius.max)(rng);
-							}
-						}
-						ApplyEffect(eff, ctx, r);
-					}
+				chancePassed = globalRoll < r.filter.chance.value;
+			}
+			if (chancePassed) {
+				for (const auto& eff : r.effects) {
+					ApplyEffect(RollEffect(eff), ctx, scratch);
 				}
 			}
 		}
-
-		// ╔════════════════════════════════════╗
-		// ║              CLEAN-UP              ║
-		// ╚════════════════════════════════════╝
-
-		CleanupCounters();
 	}
 }
@@ -0,0 +1,145 @@
+#include "Scheduler.h"
+
+namespace OIF {
+
+// ╔════════════════════════════════════╗
+// ║             SCHEDULER              ║
+// ╚════════════════════════════════════╝
+
+	Scheduler* Scheduler::GetSingleton() {
+		static Scheduler inst;
+		return &inst;
+	}
+
+	void Scheduler::RunTask(const Pending& pending)
+	{
+		if (pending.guard) {
+			RE::NiPointer<RE::TESObjectREFR> ref;
+			if (!RE::TESObjectREFR::LookupByHandle(pending.guard, ref) || !ref || ref->IsDeleted()) return;
+		}
+		pending.task();
+	}
+
+	Scheduler::TimerID Scheduler::Schedule(float delay, Task task, RE::RefHandle guard, TimerClock clock)
+	{
+		if (!task) return 0;
+
+		delay = std::max(delay, 0.0f);
+
+		TimerID id;
+		bool wake = false;
+		{
+			std::lock_guard lock(_mutex);
+			id = _nextID++;
+			_pending.emplace(id, Pending{ std::move(task), guard });
+
+			if (clock == TimerClock::kGameTime) {
+				_gameHeap.push(Due<double>{ _gameTime + delay, id });
+			} else {
+				if (!_worker.joinable()) {
+					_worker = std::jthread([this](std::stop_token stop) { Run(stop); });
+				}
+
+				// The worker only needs to wake if its next deadline moved earlier
+				const auto due = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(delay));
+				wake = _heap.empty() || due < _heap.top().time;
+				_heap.push(Due<Clock::time_point>{ due, id });
+			}
+		}
+		if (wake) _wake.notify_one();
+
+		return id;
+	}
+
+	void Scheduler::AdvanceGameTime(float delta, std::size_t maxTasks)
+	{
+		{
+			std::lock_guard lock(_mutex);
+			if (delta > 0.0f) _gameTime += delta;
+
+			while (!_gameHeap.empty() && _gameHeap.top().time <= _gameTime && _gameBatch.size() < maxTasks) {
+				const TimerID id = _gameHeap.top().id;
+				_gameHeap.pop();
+				if (auto it = _pending.find(id); it != _pending.end()) {
+					_gameBatch.push_back(std::move(it->second));
+					_pending.erase(it);
+				}
+			}
+		}
+
+		// Already on the game thread, tasks run without the lock so they can schedule further timers
+		for (const auto& pending : _gameBatch) {
+			RunTask(pending);
+		}
+		_gameBatch.clear();
+	}
+
+	bool Scheduler::Cancel(TimerID id)
+	{
+		std::lock_guard lock(_mutex);
+		return _pending.erase(id) > 0;
+	}
+
+	void Scheduler::CancelAll()
+	{
+		{
+			std::lock_guard lock(_mutex);
+			_pending.clear();
+			_heap = {};
+			_gameHeap = {};
+		}
+		_wake.notify_one();
+	}
+
+	std::size_t Scheduler::GetPendingCount() const
+	{
+		std::lock_guard lock(_mutex);
+		return _pending.size();
+	}
+
+	double Scheduler::GetGameTime() const
+	{
+		std::lock_guard lock(_mutex);
+		return _gameTime;
+	}
+
+	void Scheduler::Run(std::stop_token stop)
+	{
+		std::vector<Pending> batch;
+		std::unique_lock lock(_mutex);
+
+		while (!stop.stop_requested()) {
+			if (_heap.empty()) {
+				_wake.wait(lock, stop, [this] { return !_heap.empty(); });
+				continue;
+			}
+
+			const auto next = _heap.top().time;
+			if (next > Clock::now()) {
+				_wake.wait_until(lock, stop, next, [this, next] { return _heap.empty() || _heap.top().time < next; });
+				continue;
+			}
+
+			// Everything due by now goes to the game thread as one task
+			const auto now = Clock::now();
+			while (!_heap.empty() && _heap.top().time <= now) {
+				const TimerID id = _heap.top().id;
+				_heap.pop();
+				if (auto it = _pending.find(id); it != _pending.end()) {
+					batch.push_back(std::move(it->second));
+					_pending.erase(it);
+				}
+			}
+			if (batch.empty()) continue;
+
+			lock.unlock();
+			SKSE::GetTaskInterface()->AddTask([tasks = std::move(batch)]() {
+				for (const auto& pending : tasks) {
+					RunTask(pending);
+				}
+			});
+			batch.clear();
+			lock.lock();
+		}
+	}
+}
@@ -0,0 +1,84 @@
+#include "Settings.h"
+#include <nlohmann/json.hpp>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace OIF {
+
+//██╗░░██╗███████╗██╗░░░░░██████╗░███████╗██████╗░░██████╗
+//██║░░██║██╔════╝██║░░░░░██╔══██╗██╔════╝██╔══██╗██╔════╝
+//███████║█████╗░░██║░░░░░██████╔╝█████╗░░██████╔╝╚█████╗░
+//██╔══██║██╔══╝░░██║░░░░░██╔═══╝░██╔══╝░░██╔══██╗░╚═══██╗
+//██║░░██║███████╗███████╗██║░░░░░███████╗██║░░██║██████╔╝
+//╚═╝░░╚═╝╚══════╝╚══════╝╚═╝░░░░░╚══════╝╚═╝░░╚═╝╚═════╝░
+
+	// Looks up a key case-insensitively and copies it into value if the type fits
+	template <class T>
+	static void ReadSetting(const json& j, std::string_view key, T& value)
+	{
+		for (auto it = j.begin(); it != j.end(); ++it) {
+			if (!std::ranges::equal(it.key(), key, [](unsigned char a, unsigned char b) { return std::tolower(a) == std::tolower(b); })) continue;
+
+			if constexpr (std::is_same_v<T, bool>) {
+				if (it->is_boolean()) value = it->get<bool>();
+				else if (it->is_number_integer()) value = it->get<int>() != 0;
+				else logger::warn("Setting '{}' must be a boolean", key);
+			} else {
+				if (it->is_number()) value = it->get<T>();
+				else logger::warn("Setting '{}' must be a number", key);
+			}
+			return;
+		}
+	}
+
+
+//░██████╗███████╗████████╗████████╗██╗███╗░░██╗░██████╗░░██████╗
+//██╔════╝██╔════╝╚══██╔══╝╚══██╔══╝██║████╗░██║██╔════╝░██╔════╝
+//╚█████╗░█████╗░░░░░██║░░░░░░██║░░░██║██╔██╗██║██║░░██╗░╚█████╗░
+//░╚═══██╗██╔══╝░░░░░██║░░░░░░██║░░░██║██║╚████║██║░░╚██╗░╚═══██╗
+//██████╔╝███████╗░░░██║░░░░░░██║░░░██║██║░╚███║╚██████╔╝██████╔╝
+//╚═════╝░╚══════╝░░░╚═╝░░░░░░╚═╝░░░╚═╝╚═╝░░╚══╝░╚═════╝░╚═════╝░
+
+	Settings* Settings::GetSingleton() {
+		static Settings inst;
+		return &inst;
+	}
+
+	void Settings::Load() {
+		const fs::path path{ "Data/SKSE/Plugins/ObjectImpactFramework.json" };
+		if (!fs::exists(path)) {
+			logger::info("Settings file not found, using defaults: {}", path.string());
+			return;
+		}
+
+		std::ifstream ifs(path);
+		if (!ifs.is_open()) {
+			logger::error("Failed to open settings file: {}", path.string());
+			return;
+		}
+
+		json j;
+		try {
+			ifs >> j;
+		} catch (const std::exception& e) {
+			logger::error("Error parsing {}: {}", path.string(), e.what());
+			return;
+		}
+
+		if (!j.is_object()) {
+			logger::error("Invalid settings format in {}: expected an object", path.string());
+			return;
+		}
+
+		ReadSetting(j, "freezePredicateOrder", freezePredicateOrder);
+		ReadSetting(j, "predicateReorderInterval", predicateReorderInterval);
+		ReadSetting(j, "predicateReorderMinSamples", predicateReorderMinSamples);
+		ReadSetting(j, "counterMemoryCapKB", counterMemoryCapKB);
+		ReadSetting(j, "interactionCounterMaxAge", interactionCounterMaxAge);
+		ReadSetting(j, "gameTimerTasksPerFrame", gameTimerTasksPerFrame);
+		ReadSetting(j, "effectBudgetMs", effectBudgetMs);
+
+		logger::info("Settings loaded from {}", path.string());
+	}
+}
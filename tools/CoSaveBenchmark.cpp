@@ -0,0 +1,132 @@
+// Times the LCNT co-save layouts over synthetic limit counters, without the plugin's counter memory cap.
+// Usage: CoSaveBenchmark [entries = 100000]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <tuple>
+#include <vector>
+#include "CounterCodec.h"
+
+using namespace OIF;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+	// Version 2 layout: the plugin's Key struct and the value, written one after the other per entry
+	struct LegacyKey {
+		std::uint32_t sourceID;
+		std::uint32_t targetID;
+		std::uint16_t ruleIdx;
+	};
+
+	double Ms(Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); }
+
+	bool Less(const SavedCount& a, const SavedCount& b) {
+		return std::tie(a.ruleID, a.sourceID, a.targetID) < std::tie(b.ruleID, b.sourceID, b.targetID);
+	}
+
+	bool Same(const SavedCount& a, const SavedCount& b) {
+		return a.ruleID == b.ruleID && a.sourceID == b.sourceID && a.targetID == b.targetID && a.value == b.value;
+	}
+
+	// Mostly the player as source and targets spread over a couple of plugins, keys are unique like in the live table
+	std::vector<SavedCount> MakeCounts(std::size_t entries, std::uint32_t rules) {
+		std::mt19937 rng(0x4F49464C);
+		std::uniform_int_distribution<std::uint32_t> ruleDist(0, rules - 1);
+		std::uniform_int_distribution<std::uint32_t> sourceDist(0, 15);
+		std::uniform_int_distribution<std::uint32_t> targetDist(0x00000800, 0x0010FFFF);
+		std::uniform_int_distribution<std::uint32_t> valueDist(1, 8);
+
+		std::vector<SavedCount> counts;
+		counts.reserve(entries);
+		while (counts.size() < entries) {
+			const std::uint32_t rule = 0x9E3779B9u * (ruleDist(rng) + 1);				// stable IDs are hashes, not indices
+			const std::uint32_t source = sourceDist(rng) ? 0x00000014 : targetDist(rng);
+			const std::uint32_t target = targetDist(rng) | (static_cast<std::uint32_t>(counts.size() & 1) << 24);
+			counts.push_back({ rule, source, target, valueDist(rng) });
+			if (counts.size() == entries) {
+				std::ranges::sort(counts, Less);
+				const auto dup = std::ranges::unique(counts, [](const SavedCount& a, const SavedCount& b) { return !Less(a, b) && !Less(b, a); });
+				counts.erase(dup.begin(), dup.end());
+			}
+		}
+		return counts;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const std::size_t entries = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+	constexpr std::uint32_t kRules = 2000;
+	if (!entries) {
+		std::fprintf(stderr, "Usage: %s [entries]\n", argv[0]);
+		return 2;
+	}
+
+	const auto counts = MakeCounts(entries, kRules);
+
+	// Bulk layout (version 3)
+	auto toEncode = counts;
+	auto start = Clock::now();
+	const auto bulk = CounterCodec::Encode(toEncode);
+	const auto encodeTime = Clock::now() - start;
+
+	std::vector<SavedCount> decoded;
+	start = Clock::now();
+	const bool bulkOk = CounterCodec::Decode(bulk, decoded);
+	const auto decodeTime = Clock::now() - start;
+
+	if (!bulkOk || decoded.size() != counts.size() || !std::ranges::equal(decoded, counts, Same)) {
+		std::fprintf(stderr, "Bulk layout did not round-trip %zu counters\n", counts.size());
+		return 1;
+	}
+
+	// Legacy layout (version 2), rule IDs stand in for indices since only the size and the read pattern matter
+	std::vector<std::uint8_t> legacy;
+	start = Clock::now();
+	const auto append = [&legacy](const void* src, std::size_t size) {
+		const auto* bytes = static_cast<const std::uint8_t*>(src);
+		legacy.insert(legacy.end(), bytes, bytes + size);
+	};
+	const auto size = static_cast<std::uint32_t>(counts.size());
+	append(&size, sizeof(size));
+	for (const auto& c : counts) {
+		const LegacyKey key{ c.sourceID, c.targetID, static_cast<std::uint16_t>(c.ruleID) };
+		append(&key, sizeof(key));
+		append(&c.value, sizeof(c.value));
+	}
+	const auto legacyWriteTime = Clock::now() - start;
+
+	std::vector<SavedCount> legacyRead;
+	start = Clock::now();
+	std::size_t pos = 0;
+	const auto read = [&legacy, &pos](void* dst, std::size_t len) {
+		if (legacy.size() - pos < len) return false;
+		std::memcpy(dst, legacy.data() + pos, len);
+		pos += len;
+		return true;
+	};
+	std::uint32_t legacySize = 0;
+	read(&legacySize, sizeof(legacySize));
+	legacyRead.reserve(legacySize);
+	for (std::uint32_t i = 0; i < legacySize; ++i) {
+		LegacyKey key;
+		std::uint32_t val;
+		if (!read(&key, sizeof(key)) || !read(&val, sizeof(val))) break;
+		legacyRead.push_back({ key.ruleIdx, key.sourceID, key.targetID, val });
+	}
+	const auto legacyReadTime = Clock::now() - start;
+
+	if (legacyRead.size() != counts.size()) {
+		std::fprintf(stderr, "Legacy layout did not round-trip %zu counters\n", counts.size());
+		return 1;
+	}
+
+	std::printf("%zu counters, %u rules\n", counts.size(), kRules);
+	std::printf("  bulk   %9zu bytes  encode %8.2f ms  decode %8.2f ms\n", bulk.size(), Ms(encodeTime), Ms(decodeTime));
+	std::printf("  legacy %9zu bytes  write  %8.2f ms  read   %8.2f ms\n", legacy.size(), Ms(legacyWriteTime), Ms(legacyReadTime));
+	return 0;
+}